@@ -6,7 +6,10 @@
 ////////////////////////////////////////////////////////////////////////////
 
 // Get Data from .csv Files in Folder. Data determined by names.cc output file or choose own file
-// write to file "Ambient_data_YEAR.txt"
+// write to file "Ambient_data_YEAR.pcol" (column store) and "Ambient_data_YEAR.txt"
+// "./Ambient.o --input DIR --output DIR --year YEAR --batch" runs without dialogs, see run_options.h
+// "--years 2018-2022" writes Ambient_data_2018-2022.pcol of all files, eval_air_std.cc splits it into the years
+// parsed files are kept in Ambient_data_YEAR_store, later runs only parse new or changed files ("--rebuild" parses all again)
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // compile command for linux:                                                                                            //
@@ -23,6 +26,26 @@
 //////////////////////////////////////////////////////////////////////////////////
 #include "tinyfiledialogs.h"
 
+//shared reader for Picarro csv files
+#include "picarro_reader.h"
+//typed columns and binary column store for the output file
+#include "data_columns.h"
+#include "column_store.h"
+//only new or changed files are parsed
+#include "ingest_store.h"
+//csv files of the folder in time order
+#include "file_catalog.h"
+//rows of all files in time order
+#include "time_merge.h"
+//command line and config file options
+#include "run_options.h"
+//--threads for the parallel loops
+#include "thread_limit.h"
+//stage times and counters
+#include "stage_report.h"
+//messages of the parallel parsing
+#include "logger.h"
+
 ////////////////////
 // C/C++ includes //
 ////////////////////
@@ -32,7 +55,10 @@
 #include <filesystem> //using c++-17 filesystem
 #include <fstream> //for reading and writing to files
 #include <sstream> //for reading files
+#include <string_view> //for fields of the mapped files
 #include <algorithm> //for different C/C++ functions
+#include <cstdint> //fixed size types
+#include <limits> //for NaN
 #include <ctime>  //for time
 #include <execution> //for parallel stuff
 #include <pthread.h> //multithreading
@@ -67,8 +93,9 @@ namespace fs = std::filesystem;
 class Data
 {
 public:
-    vector<string> port, timed, H2O_mean, O18, H2;
-    vector<TDatime> date;
+    DictColumn port;
+    vector<double> timed, H2O_mean, O18, H2;
+    vector<int64_t> epoch;
     string ID_name;
     string file_name = "0";
 
@@ -77,35 +104,18 @@ public:
     ~Data(){};
 };
 
-//getting files for evaluation
-void getFiles(vector<string> &names, vector<string> &dates, vector<string> &adresses)
+//getting files for evaluation, sorted by the time in their names
+void getFiles(string afilepath, FileCatalog &catalog)
 {
-    string afilepath = tinyfd_selectFolderDialog("Choose Folder with csv Files", ".");
-
-    string filesubstr;
-    fs::path pafilepath(afilepath);
-    fs::directory_iterator end_itr;
-    for (fs::directory_iterator itr(pafilepath); itr != end_itr; ++itr)
-    {
-        if (fs::is_regular_file(itr->path()))
-        {
-            filesubstr = itr->path().filename().string();
-            filesubstr = filesubstr.substr(filesubstr.size()-4,4);
-            if (filesubstr == ".csv")
-            {
-                names.push_back(itr->path().filename().string());
-                dates.push_back(itr->path().filename().string().substr(itr->path().filename().string().size()-19, 8));
-                adresses.push_back(itr->path());
-            };
-        };
-    };
+    catalog.scan(afilepath, ".csv");
     cout << "===================" << endl;
     cout << "Reading files" << endl;
     cout << "===================" << endl;
 
-    for (int i = 0; i < names.size(); i++)
+    for (int i = 0; i < catalog.size(); i++)
     {
-        cout << i << ". " << names[i] << " from " << dates[i] << " at " << adresses[i] << endl;
+        cout << i << ". " << catalog[i].name << " from " << catalog[i].start << " at " << catalog[i].path << endl;
+        if (catalog[i].start < 0){cout << "   no time in file name, evaluated after the others" << endl;};
     };
 };
 
@@ -120,12 +130,6 @@ bool checkID_same(vector<string> identifier, string data_ID)
     return ID_same;
 };
 
-//check date
-bool int_compare(int i, int j)
-{
-    return (i < j);
-};
-
 //get identifers
 void getID(vector<string> &identifiers)
 {
@@ -145,114 +149,122 @@ void getID(vector<string> &identifiers)
     inFile.close();
 };
 
-//getting Data from files
-void getData(string name, string files_adress, Data &data)
+//rows of one part of a file, parsed independently of the other parts
+//row_flags has one entry per line, the values only for Ambient lines
+enum RowFlags : uint8_t
+{
+    row_ambient = 1,
+    row_H2O = 2
+};
+class Chunk
+{
+public:
+    string_view text;
+    vector<uint8_t> row_flags;
+    vector<double> timed, H2O_mean, O18, H2;
+    vector<int64_t> epoch;
+};
+
+//parse lines of one chunk, everything that does not depend on the rows before
+void parseChunk(Chunk &chunk)
 {
-    string line_r, analysis_r, time_code_r, port_r, inj_nmb_r, O18w_r, H2w_r, H2Ow_mean_r, ignore_r, good_r, O18v_r, H2v_r, H2Ov_mean_r, identifier1_r, identifier2_r, gas_conf_r, time_mean_r, O18_sd_r, H2_sd_r, H2O_sd_r, O18_sl_r, H2_sl_r, H2O_sl_r, base_shift_r, slope_r, res_r, base_curv_r, interval_r, CH4_r, H2O_adj_r, H2O_shift_r, n2_r, temp_r, tray_r, sample_r, job_r, method_r, error_r;
-    TDatime date_code;
+    string_view field[picarro_columns];
+    TimeStamp time_stamp;
     double O18r,H2r;
-    string last_analysis = "none";
-    int memory = 0;
-    //loop over alle files
-    ifstream inFile (files_adress);
-    cout << "Reading file " << name << " ..." << endl;
+    string_view text = chunk.text;
+    string_view line;
+    LogTally &bad_time = logger.tally("rows with unreadable time code");
+    LogTally &bad_value = logger.tally("Ambient rows with unreadable values");
+    while (nextLine(text, line))
+    {
+        splitFields(line, ',', field, picarro_columns);
+        string_view port_r = field[col_port];
+
+        //decode time "YYYY/MM/DD HH:MM:SS.sss"
+        if (!decodeTimestamp(field[col_time_code], time_stamp))
+        {
+            bad_time.add("Time Code: ", field[col_time_code], " at ", field[col_time_mean]);
+            time_stamp = TimeStamp();
+            time_stamp.time_code = numeric_limits<double>::quiet_NaN();
+        };
+        if(port_r == "Ambient" && (!parseDouble(field[col_O18v], O18r) || !parseDouble(field[col_H2v], H2r)))
+        {
+            bad_value.add("Time Code: ", field[col_time_code], " at ", field[col_time_mean]);
+        };
+
+        uint8_t flags = 0;
+        if (port_r == "Ambient")
+        {
+            flags |= row_ambient;
+            chunk.timed.push_back(time_stamp.time_code);
+            chunk.epoch.push_back(time_stamp.epoch);
+            chunk.H2O_mean.push_back(parseValue(field[col_H2Ov_mean]));
+            chunk.O18.push_back(parseValue(field[col_O18v]));
+            chunk.H2.push_back(parseValue(field[col_H2v]));
+        };
+        if (field[col_gas_conf] == "H2O"){flags |= row_H2O;};
+        chunk.row_flags.push_back(flags);
+    };
+};
+
+//getting Data from files
+//the file is cut into newline aligned chunks which are parsed in parallel,
+//the memory correction runs over the rows of all chunks in file order afterwards
+void getData(string name, string files_adress, Data &data, size_t chunk_size = 8 << 20)
+{
+    MemoryFilter memory;
+    //map file, lines and fields are views into the mapping
+    MappedFile inFile (files_adress);
+    logger.info("Reading file ", name, " ...");
     data.file_name = name;
     // read signal values from file
-	if (inFile.is_open())
+	if (inFile.isOpen())
 	{
-        int i = 0;
-        string line;
-        while (getline(inFile, line))
-		{
-            remove(line.begin(), line.end(), ' ');
-            stringstream stst(line);
-            getline(stst,line_r,',');
-            getline(stst,analysis_r,',');
-            getline(stst,time_code_r,',');
-            getline(stst,port_r,',');
-            getline(stst,inj_nmb_r,',');
-            getline(stst,O18w_r,',');
-            getline(stst,H2w_r,',');
-            getline(stst,H2Ow_mean_r,',');
-            getline(stst,ignore_r,',');
-            getline(stst,good_r,',');
-            getline(stst,O18v_r,',');
-            getline(stst,H2v_r,',');
-            getline(stst,H2Ov_mean_r,',');
-            getline(stst,identifier1_r,',');
-            getline(stst,identifier2_r,',');
-            getline(stst,gas_conf_r,',');
-            getline(stst,time_mean_r,',');
-            getline(stst,O18_sd_r,',');
-            getline(stst,H2_sd_r,',');
-            getline(stst,H2O_sd_r,',');
-            getline(stst,O18_sl_r,',');
-            getline(stst,H2_sl_r,',');
-            getline(stst,H2O_sl_r,',');
-            getline(stst,base_shift_r,',');
-            getline(stst,slope_r,',');
-            getline(stst,res_r,',');
-            getline(stst,base_curv_r,',');
-            getline(stst,interval_r,',');
-            getline(stst,CH4_r,',');
-            getline(stst,H2O_adj_r,',');
-            getline(stst,H2O_shift_r,',');
-            getline(stst,n2_r,',');
-            getline(stst,temp_r,',');
-            getline(stst,tray_r,',');
-            getline(stst,sample_r,',');
-            getline(stst,job_r,',');
-            getline(stst,method_r,',');
-            getline(stst,error_r,',');
-
-            //format time format
-            remove(time_code_r.begin(), time_code_r.end(), '/');
-            remove(time_code_r.begin(), time_code_r.end(), ':');
-            for (int j = 0; j < 4; j++) {if (!time_code_r.empty()) {time_code_r.pop_back();};};
-
-            if (i == 0) {i = 1; continue;};
-            try
+        string_view text = inFile.view();
+        string_view line;
+        //header
+        nextLine(text, line);
+
+        vector<string_view> parts = splitChunks(text, chunk_size);
+        vector<Chunk> chunks(parts.size());
+        for (size_t c = 0; c < parts.size(); c++){chunks[c].text = parts[c];};
+        for_each(execution::par, chunks.begin(), chunks.end(), parseChunk);
+
+        size_t n_ambient = 0, n_rows = 0, n_skipped = 0;
+        for (size_t c = 0; c < chunks.size(); c++){n_ambient += chunks[c].timed.size(); n_rows += chunks[c].row_flags.size();};
+        data.port.reserve(n_ambient);
+        data.timed.reserve(n_ambient);
+        data.epoch.reserve(n_ambient);
+        data.H2O_mean.reserve(n_ambient);
+        data.O18.reserve(n_ambient);
+        data.H2.reserve(n_ambient);
+
+        for (size_t c = 0; c < chunks.size(); c++)
+        {
+            Chunk &chunk = chunks[c];
+            size_t k = 0; //next Ambient row of chunk
+            for (size_t r = 0; r < chunk.row_flags.size(); r++)
             {
-                date_code.Set
-                (
-                    stoi(time_code_r.substr(0,4)),
-                    stoi(time_code_r.substr(4,2)),
-                    stoi(time_code_r.substr(6,2)),
-                    stoi(time_code_r.substr(8,2)),
-                    stoi(time_code_r.substr(10,2)),
-                    stoi(time_code_r.substr(12,2))
-                );
-                if(port_r == "Ambient")
+                bool ambient = chunk.row_flags[r] & row_ambient;
+                //memory correction
+                if (!memory.keep(ambient, chunk.row_flags[r] & row_H2O))
                 {
-                    O18r = stod(O18v_r);
-                    H2r = stod(H2v_r);
+                    if (ambient){k++; n_skipped++;};
+                    continue;
                 };
-            }
-            catch (...)
-            {
-                cout << "Time Code: " << time_code_r << " at " << time_mean_r << endl;
-            }
-            //memory correction
-            if (port_r == "Ambient" && last_analysis == "H2O")
-            {
-                memory++;
-                if(memory <= 180){continue;};
+                data.port.push_back("Ambient");
+                data.timed.push_back(chunk.timed[k]);
+                data.epoch.push_back(chunk.epoch[k]);
+                data.H2O_mean.push_back(chunk.H2O_mean[k]);
+                data.O18.push_back(chunk.O18[k]);
+                data.H2.push_back(chunk.H2[k]);
+                k++;
             };
-            if(memory >= 180)
-            {
-                memory = 0;
-            };
-
-            if (port_r == "Ambient")
-            {
-                data.port.push_back(port_r);
-                data.timed.push_back(time_code_r);
-                data.H2O_mean.push_back(H2Ov_mean_r);
-                data.O18.push_back(O18v_r);
-                data.H2.push_back(H2v_r);
-            };
-            last_analysis = gas_conf_r;
-		};
+            chunk = Chunk();
+        };
+        stage_report.count("parse", "rows read", n_rows);
+        stage_report.count("parse", "ambient rows", n_ambient);
+        stage_report.count("parse", "memory skipped rows", n_skipped);
 	};
     //verbose identifiers
     // for (int i = 0; i < data.size(); i++)
@@ -263,134 +275,185 @@ void getData(string name, string files_adress, Data &data)
 
 };
 
+//parsed file as segment of the ingest store
+bool writeSegment(string path, Data &data)
+{
+    StoreWriter store("Ambient");
+    store.meta = data.file_name;
+    store.addDouble("Time", data.timed);
+    store.addInt64("Epoch", data.epoch);
+    store.addDict("Port", data.port);
+    store.addDouble("H2O mean", data.H2O_mean);
+    store.addDouble("O18", data.O18);
+    store.addDouble("H2", data.H2);
+    return store.write(path);
+};
+
+//file from its segment instead of parsing it again
+bool readSegment(string path, Data &data)
+{
+    StoreReader store(path);
+    if (!store.isOpen()){return 0;};
+    const double *timed = store.getDouble("Time");
+    const int64_t *epoch = store.getInt64("Epoch");
+    const int32_t *port = store.getCodes("Port");
+    const double *H2O_mean = store.getDouble("H2O mean");
+    const double *O18 = store.getDouble("O18");
+    const double *H2 = store.getDouble("H2");
+    if (!timed || !epoch || !port || !H2O_mean || !O18 || !H2){return 0;};
+    size_t n = store.rows();
+    const vector<string_view> &ports = store.dictionary("Port");
+    data.port.reserve(n);
+    for (size_t i = 0; i < n; i++){data.port.push_back(ports[port[i]]);};
+    data.timed.assign(timed, timed + n);
+    data.epoch.assign(epoch, epoch + n);
+    data.H2O_mean.assign(H2O_mean, H2O_mean + n);
+    data.O18.assign(O18, O18 + n);
+    data.H2.assign(H2, H2 + n);
+    return 1;
+};
+
 //write evaluated Data
-void writeData(string year, string evalpath, vector<string> files_name, vector<Data> &data)
+//Ambient_data_YEAR.pcol is read by eval_air_std.cc, Ambient_data_YEAR.txt is exported from it for reading
+void writeData(string year, string evalpath, const vector<string> &files_name, const vector<Data> &data)
 {
     time_t t = time(0);
     string c_time = ctime(&t);
     string curr_time = c_time.substr(8,2) + c_time.substr(4,3) + c_time.substr(20,4) + "_" + c_time.substr(11,2) + c_time.substr(14,2) + c_time.substr(17,2);
     cout << "current time: " << curr_time << endl;
     string OutputFileName;
-    OutputFileName = "Ambient_data_" + year + ".txt";
-    ofstream outFile (evalpath + "/" + OutputFileName);
-    outFile << "Evaluation from: " << c_time << endl;
-    outFile << "Type: Ambient" << endl << endl;
-    outFile << "Files evaluated: " << endl;
+    OutputFileName = "Ambient_data_" + year;
+
+    //header of the text file
+    stringstream meta;
+    meta << "Evaluation from: " << c_time << endl;
+    meta << "Type: Ambient" << endl << endl;
+    meta << "Files evaluated: " << endl;
     for (int i = 0; i < files_name.size(); i++)
     {
-        outFile << files_name[i] << endl;
+        meta << files_name[i] << endl;
     };
-    outFile << endl << "========================" << endl << "Raw Data" << endl << "========================" << endl;
-    outFile << "Time," << "Port," << "H2O mean," << "O18," << "H2" << endl;
+    meta << endl << "========================" << endl << "Raw Data" << endl << "========================" << endl;
 
-    for (int i = 0; i < data.size(); i++)
+    //rows of all files merged in time order straight into the store, rows of overlapping files only once
+    vector<const vector<double>*> times;
+    for (int i = 0; i < data.size(); i++){times.push_back(&data[i].timed);};
+    TimeMerge merge(times, [&data](size_t f, size_t r, size_t g, size_t s)
     {
-        for (int j = 0; j < data[i].timed.size(); j++)
-        {
-            outFile << data[i].timed[j] << "," << data[i].port[j] << "," << data[i].H2O_mean[j] << "," << data[i].O18[j] << "," << data[i].H2[j] << endl;
-        };
+        return data[f].port[r] == data[g].port[s] && sameValue(data[f].H2O_mean[r], data[g].H2O_mean[s]) && sameValue(data[f].O18[r], data[g].O18[s]) && sameValue(data[f].H2[r], data[g].H2[s]);
+    });
+    StoreRowWriter store("Ambient", evalpath + "/" + OutputFileName + store_extension, {"Time", "Port", "H2O mean", "O18", "H2"}, {-1, 0, -1, -1, -1});
+    if (!store.isOpen())
+    {
+        cout << "Could not write " << evalpath + "/" + OutputFileName + store_extension << endl;
+        return;
+    };
+    store.meta = meta.str();
+    Dictionary ports;
+    size_t f, r;
+    while (merge.next(f, r))
+    {
+        double row[5] = {data[f].timed[r], static_cast<double>(ports.add(data[f].port[r])), data[f].H2O_mean[r], data[f].O18[r], data[f].H2[r]};
+        store.push(row);
     };
+    store.setDict(1, ports.names);
+    if (!store.close())
+    {
+        cout << "Could not write " << evalpath + "/" + OutputFileName + store_extension << endl;
+        return;
+    };
+    stage_report.count("write", "rows written", store.rows());
+    stage_report.count("write", "duplicate rows", merge.duplicates());
+    cout << "Merged " << store.rows() << " rows from " << merge.runs() << " time ordered runs, " << merge.duplicates() << " duplicate rows dropped" << endl;
+    StoreReader written(evalpath + "/" + OutputFileName + store_extension);
+    written.exportText(evalpath + "/" + OutputFileName + ".txt");
+    cout << "Output Files: " << OutputFileName + store_extension << " and " << OutputFileName + ".txt" << endl;
 };
 
 int main(int argc, char* argv[])
 {
+    RunOptions options(argc, argv,
+        "  --input DIR        folder with csv files\n"
+        "  --output DIR       folder for evaluation\n"
+        "  --year YEAR        year to evaluate\n"
+        "  --years FIRST-LAST all files of the range in one run, outputs are named FIRST-LAST\n"
+        "  --threads N        threads for the parallel loops\n"
+        "  --rebuild          parse all files again instead of only new or changed ones\n");
+    ThreadLimit threads(options.number("threads", 0));
+
     //////////////////////////////////
     // Name, date and path to files //
     //////////////////////////////////
-    vector<string> files_name;
-    vector<string> files_date;
-    vector<string> files_adress;
+    FileCatalog catalog;
     string year;
+    stage_report.setProgram("ambient");
 
-    getFiles(files_name, files_date, files_adress);
+    string inputpath = options.selectFolder("input", "Choose Folder with csv Files");
+    {
+        auto timer = stage_report.time("catalog");
+        getFiles(inputpath, catalog);
+        stage_report.count("catalog", "files", catalog.size());
+    };
     //choose directory for evaluation data
-    string evalpath = tinyfd_selectFolderDialog("Choose Folder for Evaluation", ".");
+    string evalpath = options.selectFolder("output", "Choose Folder for Evaluation");
     cout << "Evalpath " << evalpath << endl;
     cout << "############" << endl;
-    cout << "Which year?" << endl;
+    //a range only names the outputs, the files of the folder are all read like for a single year
+    year = options.years().label();
     cout << "############" << endl;
-    cin >> year;
     //cout << year << endl; //debug
 
     //////////////////////////////////////////////////
     // Read csv file(s) and store values in vectors //
     //////////////////////////////////////////////////
-    vector<Data> data, data_sorted;
-
-    vector<int> parItr, endposition;
-
-    int reservedN = 200; //How much files are there
-    for (int i = 0; i < reservedN; i++){ data.push_back(Data()); };
-
-    for (int i = 0; i < files_adress.size(); i++){ parItr.push_back(i); };
-
-    //loop over alle files and read signal
-    auto files_loop = [files_name, files_adress, &data](int i)
-    {
-        cout << i << ". ";
-        getData(files_name[i], files_adress[i], data[i]);
-        data[i].file_name = files_name[i];
-        //cout << data[i].file_name.substr(18,8) << data[i].file_name.substr(27,6) << endl;
-    };
-    for_each(execution::par,parItr.begin(),parItr.end(),files_loop);
-
-    //sort Data to date
-    string date_name;
-    long int date_int;
-    int year_akt, yearr;
-    vector<long int> date;
-    for (int i = 0; i < data.size(); i++)
-    {
-        if (data[i].file_name == "0"){continue;};
-        date_name = data[i].file_name.substr(18,8) + data[i].file_name.substr(27,6);
-        try
-        {
-            date_int = stol(date_name);
-        }
-        catch (...)
-        {
-            cout << "aborted because of '" << date_name << "'" << endl;
-        }
-        date.push_back(date_int);
-    };
-
-    cout << "sorting..." << endl;
-    cout << "##########" << endl;
-    std::sort(date.begin(), date.end(), int_compare);
-    for (int i = date.size()-1; i != 0; i--)
+    //one Data per file in catalog (time) order
+    vector<Data> data(catalog.size());
+
+    vector<int> parItr;
+    for (int i = 0; i < catalog.size(); i++){ parItr.push_back(i); };
+
+    //only new or changed files are parsed, the others come from their segments
+    IngestStore ingest(evalpath + "/Ambient_data_" + year + "_store", "Ambient 1", options.flag("rebuild"));
+    vector<ManifestEntry> entries(catalog.size());
+    vector<char> parse(catalog.size()), parsed(catalog.size());
+    int n_parse = 0;
+    auto parse_timer = stage_report.time("parse");
+    for (int i = 0; i < catalog.size(); i++)
     {
-        date_name = to_string(date[i]);
-        year_akt = stoi(date_name.substr(0,4));
-        yearr = stoi(year);
-        if (year_akt < yearr)
-        {
-            date.insert(date.begin(), date[i]);
-            date.pop_back();
-        };
+        parse[i] = ingest.needsParsing(catalog[i].path, entries[i]);
+        n_parse += parse[i];
     };
+    cout << "Parsing " << n_parse << " new or changed of " << catalog.size() << " files" << endl;
 
-    for (int i = 0; i < date.size(); i++)
+    //loop over alle files and read signal
+    auto files_loop = [&catalog, &data, &ingest, &entries, &parse, &parsed](int i)
     {
-        cout << date[i] << endl;
+        data[i].file_name = catalog[i].name;
+        if (!parse[i] && readSegment(ingest.segmentPath(entries[i]), data[i])){return;};
+        data[i] = Data();
+        getData(catalog[i].name, catalog[i].path, data[i]);
+        data[i].file_name = catalog[i].name;
+        parsed[i] = writeSegment(ingest.segmentPath(entries[i]), data[i]);
     };
-    cout << endl;
-    cout << "########" << endl;
+    for_each(execution::par,parItr.begin(),parItr.end(),files_loop);
+    //lines of the workers are written before the program prints again
+    logger.flush();
+    for (int i = 0; i < catalog.size(); i++){if (parsed[i]){ingest.commit(entries[i]);};};
+    ingest.retain(catalog.paths());
+    if (!ingest.save()){cout << "Could not save manifest of " << evalpath + "/Ambient_data_" + year + "_store" << endl;};
+    stage_report.count("parse", "files parsed", n_parse);
+    stage_report.count("parse", "files from store", catalog.size() - n_parse);
+    parse_timer.stop();
 
-    for (int i = 0; i < date.size(); i++)
     {
-        for (int j = 0; j < data.size(); j++)
-        {
-            if (data[j].file_name == "0"){continue;};
-            date_name = data[j].file_name.substr(18,8) + data[j].file_name.substr(27,6);
-            //cout << "Date name: " << date_name << endl;
-            date_int = stol(date_name);
-            //cout << "Date in int: " << date_int << endl;
-            if (date[i] == date_int) {data_sorted.push_back(data[j]); cout << "sorting in " << date_int << endl;};
-        };
+        auto timer = stage_report.time("write");
+        writeData(year, evalpath, catalog.names(), data);
     };
-    data.clear();
-    writeData(year, evalpath, files_name, data_sorted);
 
+    stage_report.info("year", year);
+    stage_report.info("input", inputpath);
+    logger.summary();
+    stage_report.write(options.get("report", evalpath + "/Ambient_" + year + "_report"));
     return 0;
 }
 
@@ -5,9 +5,14 @@
 // version: 1 // date: 03.01.2022                                         //
 ////////////////////////////////////////////////////////////////////////////
 
-//get corrected data from (eval_air_std.cc) and get meteo data
+//get corrected data from (eval_air_std.cc, Ambient_data_YEAR_corr.pcol or .txt) and get meteo data
 //draw Graphs
 //write ambient data and correlated meteo data to one file
+//meteo values are taken from the nearest meteo time, "./Ambient_eval_meteo.o --tolerance 600" sets the largest difference in seconds (default 900)
+//diurnal and monthly graphs are drawn from End/Ambient_rollup_YEAR.txt, a run only adds new data to it ("--rebuild" sums it fresh)
+//"--year YEAR --ambient FILE --meteo FILE --output DIR --batch" runs without dialogs, see run_options.h
+//"--years 2018-2022 --meteo FILE,FILE,..." reads the files once and joins the range in one run,
+//the Graphs, the output file and the rollup cache are written per year like for a single year (year_range.h)
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // compile command:                                                                                                                  //
@@ -24,6 +29,29 @@
 //////////////////////////////////////////////////////////////////////////////////
 #include "tinyfiledialogs.h"
 
+//binary column store for the ambient files
+#include "column_store.h"
+//timestamp decoder
+#include "picarro_time.h"
+//command line and config file options
+#include "run_options.h"
+//drawing in worker processes
+#include "render_queue.h"
+//years of a run
+#include "year_range.h"
+//hourly, daily and monthly sums
+#include "rollup.h"
+//grouping by hour, month and season
+#include "bucket_index.h"
+//streaming mean and spread
+#include "running_stats.h"
+//fewer points for the graphs
+#include "decimate.h"
+//stage times and counters
+#include "stage_report.h"
+//warnings of the loops over rows
+#include "logger.h"
+
 ////////////////////
 // C/C++ includes //
 ////////////////////
@@ -34,6 +62,8 @@
 #include <fstream> //for reading and writing to files
 #include <sstream> //for reading files
 #include <algorithm> //for different C/C++ functions
+#include <cstdint> //fixed size types
+#include <limits> //for NaN
 #include <ctime>  //for time
 #include <execution> //for parallel stuff
 #include <pthread.h> //multithreading
@@ -45,6 +75,7 @@
 /////////////////////////////
 #include <TMath.h>
 #include <TApplication.h> //showing GUI
+#include <TROOT.h> //batch mode
 #include <TSystem.h> //System functions
 #include <TCanvas.h> //Canvas for Grahps
 #include <TFrame.h> //Frame for Graphs
@@ -70,24 +101,37 @@ namespace fs = std::filesystem;
 class Data
 {
 public:
-    vector<string> identifier, interval, hour, month_str;//, interval;
+    vector<string> identifier, interval;
     vector<double> timed, O18, H2, Dexcess, H2O, temp_amb, rh1_amb, rh2_amb, windvel_amb, winddir_amb, prec_amb;
     vector<double> windvel, contemp, rh1, rh2, grad, apress, o3g1, o3g3, no, ventemp, winddir, prec;
     vector<TDatime> date;
+    vector<int64_t> epoch;
     string file_name = "0";
     double temp_max, temp_min;
     vector<int> month_all{1,2,3,4,5,6,7,8,9,10,11,12};
-    vector<int> month;
+    vector<uint8_t> hour, month, season; //hour 0..23, month 1..12 and season (seasonOfMonth) of every point
     vector<string> month_names{"space", "January", "February", "March", "April", "May", "June", "July", "August", "September", "October", "November", "December"};
 
     Data(){};
     ~Data(){};
 };
 
+//channels of the rollup cache
+enum RollupChannel
+{
+    rollup_O18,
+    rollup_H2,
+    rollup_Dex,
+    rollup_H2O,
+    rollup_temp //ventilated temperature
+};
+const vector<string> rollup_channels{"O18", "H2", "Dexcess", "H2O", "ventemp"};
+
 //getting Meteo Data from file
 void getData_meteo(string datapath, Data &data)
 {
     string interval_r, windvel_r, contemp_r, rh1_r, rh2_r, grad_r, apress_r, o3g1_r, o3g3_r, no_r, ventemp_r, winddir_r, prec_r;
+    TimeStamp time_stamp;
     //loop over alle files
     ifstream inFile (datapath);
     string name = datapath.substr(datapath.size()-27,27);
@@ -97,6 +141,8 @@ void getData_meteo(string datapath, Data &data)
 	if (inFile.is_open())
 	{
         int i = 0;
+        long n_bad = 0;
+        LogTally &bad_row = logger.tally("meteo rows not readable");
         string line;
 
         while (getline(inFile, line))
@@ -117,22 +163,20 @@ void getData_meteo(string datapath, Data &data)
             getline(stst,ventemp_r,';');
             getline(stst,winddir_r,';');
             getline(stst,prec_r,';');
+            //decode time "YYYY-MM-DD HH:MM:SS", spaces are already removed
+            if (!decodeTimestamp(interval_r, time_stamp))
+            {
+                bad_row.add("Problem reading Meteo at ", interval_r);
+                n_bad++;
+                i++;
+                continue;
+            };
             try
             {
-                data.date.push_back(TDatime());
-                data.date.back().Set
-                (
-                    stoi(interval_r.substr(0,4)), // year
-                    stoi(interval_r.substr(5,2)), //month
-                    stoi(interval_r.substr(8,2)), //day
-                    stoi(interval_r.substr(10,2)), //hour
-                    stoi(interval_r.substr(13,2)), //minute
-                    stoi(interval_r.substr(16,2)) //second
-                );
-                remove(interval_r.begin(), interval_r.end(), '-');
-                remove(interval_r.begin(), interval_r.end(), ':');
-                interval_r = interval_r.substr(0,interval_r.size()-4);
-                data.timed.push_back(stod(interval_r));
+                data.date.push_back(TDatime(time_stamp.year, time_stamp.month, time_stamp.day, time_stamp.hour, time_stamp.min, time_stamp.sec));
+                interval_r = to_string(static_cast<long long>(time_stamp.time_code));
+                data.timed.push_back(time_stamp.time_code);
+                data.epoch.push_back(time_stamp.epoch);
                 data.interval.push_back(interval_r);
                 data.windvel.push_back(stod(windvel_r));
                 data.contemp.push_back(stod(contemp_r));
@@ -146,29 +190,87 @@ void getData_meteo(string datapath, Data &data)
                 data.ventemp.push_back(stod(ventemp_r));
                 data.winddir.push_back(stod(winddir_r));
                 data.prec.push_back(stod(prec_r));
-                data.month_str.push_back(interval_r.substr(4,2));
-                data.month.push_back(stod(interval_r.substr(4,2)));
-                if (i == 20 || i == 40){cout << name << ": " << data.date.back().Convert() << "||" << interval_r << "||" << windvel_r << "||" << contemp_r << "||" << rh1_r << "||" << rh2_r << "||" << grad_r << "||" << apress_r << "||" << o3g1_r << "||" << o3g3_r << "||" << no_r << "||" << ventemp_r << "||" << winddir_r << "||" << prec_r << endl;};
-                if (i == 20){cout << "Year " << interval_r.substr(0,4) << endl;};
+                data.hour.push_back(time_stamp.hour);
+                data.month.push_back(time_stamp.month);
+                data.season.push_back(seasonOfMonth(time_stamp.month));
+                if (i == 20 || i == 40){logger.info(name, ": ", data.date.back().Convert(), "||", interval_r, "||", windvel_r, "||", contemp_r, "||", rh1_r, "||", rh2_r, "||", grad_r, "||", apress_r, "||", o3g1_r, "||", o3g3_r, "||", no_r, "||", ventemp_r, "||", winddir_r, "||", prec_r);};
+                if (i == 20){logger.info("Year ", interval_r.substr(0,4));};
             }
             catch (...)
             {
-                cout << "Problem reading Meteo at " << interval_r << endl;
+                bad_row.add("Problem reading Meteo at ", interval_r);
+                n_bad++;
             }
             i++;
         };
+        stage_report.count("read meteo", "rows read", i > 0 ? i - 1 : 0);
+        stage_report.count("read meteo", "bad rows", n_bad);
 	};
     inFile.close();
+    logger.flush();
+};
+
+//getting Ambient Data from column store, columns are used directly from the mapped file
+bool getData_amb_store(string datapath, Data &data, const YearRange &years)
+{
+    StoreReader store(datapath);
+    const double *timed = store.getDouble("Time");
+    const double *O18 = store.getDouble("O18");
+    const double *H2 = store.getDouble("H2");
+    const double *Dexcess = store.getDouble("Dexcess");
+    const double *H2O = store.getDouble("H2O");
+    if (!store.isOpen() || !timed || !O18 || !H2 || !Dexcess || !H2O)
+    {
+        cout << "No corrected ambient column store at " << datapath << endl;
+        return 0;
+    };
+    cout << "Reading column store at " << datapath << " with " << store.rows() << " rows ..." << endl;
+    int year_c, month_c, day_c, hour_c, min_c, sec_c;
+    long n_bad = 0;
+    LogTally &bad_time = logger.tally("Ambient rows with unreadable time code");
+    stage_report.count("read ambient", "rows read", store.rows());
+    for (uint64_t i = 0; i < store.rows(); i++)
+    {
+        if (!splitTimeCode(timed[i], year_c, month_c, day_c, hour_c, min_c, sec_c))
+        {
+            bad_time.add("Time Code: ", formatNumber(timed[i]));
+            n_bad++;
+            continue;
+        };
+        if (!years.contains(year_c)){continue;};
+        data.timed.push_back(timed[i]);
+        data.date.push_back(TDatime(year_c, month_c, day_c, hour_c, min_c, sec_c));
+        data.epoch.push_back(epochFromParts(year_c, month_c, day_c, hour_c, min_c, sec_c));
+        data.H2O.push_back(H2O[i]);
+        data.O18.push_back(O18[i]);
+        data.H2.push_back(H2[i]);
+        data.Dexcess.push_back(Dexcess[i]);
+        data.hour.push_back(hour_c);
+        data.month.push_back(month_c);
+        data.season.push_back(seasonOfMonth(month_c));
+    };
+    stage_report.count("read ambient", "rows of year", data.timed.size());
+    stage_report.count("read ambient", "bad time codes", n_bad);
+    logger.flush();
+    return 1;
 };
 
 //getting Ambient Data from file and Correct
-void getData_amb(string datapath, Data &data, string &year)
+void getData_amb(string datapath, Data &data, const YearRange &years)
 {
     string time_r, O18_r, H2_r, Dexcess_r, H2O_r;
     double timer, O18r, H2r, Dexcessr, H2Or;
     TDatime date_code;
+    TimeStamp time_stamp;
 
-    //loop over alle files
+    //written by eval_air_std.cc as column store
+    if (isColumnStore(datapath))
+    {
+        getData_amb_store(datapath, data, years);
+        return;
+    };
+
+    //old text file
     ifstream inFile(datapath);
     cout << "Reading file at " << datapath << " ..." << endl;
 
@@ -176,10 +278,13 @@ void getData_amb(string datapath, Data &data, string &year)
 	if (inFile.is_open())
 	{
         int i = 0;
+        long n_rows = 0, n_bad = 0;
+        LogTally &bad_time = logger.tally("Ambient rows with unreadable time code");
         string line;
         while (getline(inFile, line))
 		{
             if (i < 1) {i++; continue;};
+            n_rows++;
 
             stringstream stst(line);
             getline(stst,time_r,',');
@@ -188,27 +293,19 @@ void getData_amb(string datapath, Data &data, string &year)
             getline(stst,Dexcess_r, ',');
             getline(stst,H2O_r,',');
 
-            try
+            //decode time code "YYYYMMDDHHMMSS.sss"
+            if (!decodeTimeCode(time_r, time_stamp))
             {
-                date_code.Set
-                (
-                    stoi(time_r.substr(0,4)), //year
-                    stoi(time_r.substr(4,2)), //month
-                    stoi(time_r.substr(6,2)), //day
-                    stoi(time_r.substr(8,2)), //hour
-                    stoi(time_r.substr(10,2)),//minutes
-                    stoi(time_r.substr(12,2)) //seconds
-                );
-                timer = stod(time_r);
-            }
-            catch (...)
-            {
-                cout << "Time Code: " << time_r << endl;
-            }
+                bad_time.add("Time Code: ", time_r);
+                n_bad++;
+                continue;
+            };
+            date_code.Set(time_stamp.year, time_stamp.month, time_stamp.day, time_stamp.hour, time_stamp.min, time_stamp.sec);
+            timer = time_stamp.time_code;
 
-            if (time_r.substr(0,4) != year){continue;};
+            if (!years.contains(time_stamp.year)){continue;};
 
-            if(time_r.substr(0,4) == year)
+            if(years.contains(time_stamp.year))
             {
                 H2Or = stod(H2O_r);
                 O18r = stod(O18_r);
@@ -216,64 +313,95 @@ void getData_amb(string datapath, Data &data, string &year)
                 Dexcessr = stod(Dexcess_r);
                 data.timed.push_back(timer);
                 data.date.push_back(date_code);
+                data.epoch.push_back(time_stamp.epoch);
                 data.H2O.push_back(H2Or);
                 data.O18.push_back(O18r);
                 data.H2.push_back(H2r);
                 data.Dexcess.push_back(Dexcessr);
-                data.hour.push_back(time_r.substr(8,2));
-                data.month_str.push_back(time_r.substr(4,2));
+                data.hour.push_back(time_stamp.hour);
+                data.month.push_back(time_stamp.month);
+                data.season.push_back(seasonOfMonth(time_stamp.month));
             };
             i++;
 		};
+        stage_report.count("read ambient", "rows read", n_rows);
+        stage_report.count("read ambient", "rows of year", data.timed.size());
+        stage_report.count("read ambient", "bad time codes", n_bad);
 	};
     inFile.close();
-
+    logger.flush();
 };
 
-//find temperature relation
-int compare_temp(double date_amb, vector<string> &meteo_date, int start)
+//meteo rows sorted by epoch
+//ambient points come in time order, so a cursor only moves forward (merge join),
+//points out of order are found by binary search
+class MeteoIndex
 {
-    string date_amb_str = to_string(date_amb);
-    string meteo_date_sstr;
-    string date_amb_sstr = date_amb_str.substr(4,6);
-    double meteo_d = 0.;
-    double diff = 10000.;
-    double allowed_diff = 900.;
-    for(int i = start; i < meteo_date.size(); i++)
+public:
+    MeteoIndex(const vector<int64_t> &epoch)
     {
-        try
-        {
-            meteo_date_sstr = meteo_date[i].substr(4,6);
-        }
-        catch (...)
-        {
-            // cout << "no data at " << i << " " << meteo_date[i] << " " << meteo_date.size() << endl;
-        }
-        if(date_amb_sstr == meteo_date_sstr)
+        for (size_t i = 0; i < epoch.size(); i++){row_.push_back(i);};
+        if (!is_sorted(epoch.begin(), epoch.end()))
         {
-            meteo_d = stod(meteo_date[i]);
-            diff = TMath::Abs(date_amb - meteo_d);
-            if(diff <= allowed_diff){return i;};
+            stable_sort(row_.begin(), row_.end(), [&epoch](size_t a, size_t b){return epoch[a] < epoch[b];});
         };
+        for (size_t i = 0; i < row_.size(); i++){epoch_.push_back(epoch[row_[i]]);};
     };
-    for(int i = start/2; i < meteo_date.size(); i++)
+
+    //row of the nearest meteo time, -1 if there is none within tolerance seconds
+    int nearest(int64_t t, int64_t tolerance)
     {
-        meteo_d = stod(meteo_date[i]);
-        diff = TMath::Abs(date_amb - meteo_d);
-        if(diff <= allowed_diff + 2000.){return i;};
+        //pos_ is the first meteo time >= t
+        if (pos_ > 0 && t <= epoch_[pos_-1])
+        {
+            pos_ = lower_bound(epoch_.begin(), epoch_.end(), t) - epoch_.begin();
+        };
+        while (pos_ < epoch_.size() && epoch_[pos_] < t){pos_++;};
+        int best = -1;
+        int64_t best_diff = tolerance;
+        if (pos_ > 0 && t - epoch_[pos_-1] <= best_diff){best = pos_-1; best_diff = t - epoch_[pos_-1];};
+        if (pos_ < epoch_.size() && epoch_[pos_] - t <= tolerance && (best < 0 || epoch_[pos_] - t < best_diff)){best = pos_;};
+        return best < 0 ? -1 : row_[best];
     };
-    cout << "Next value " << start+1 << " at " << meteo_date[start+1] << "||" << date_amb_str << endl;
-    return start+1;
+
+private:
+    vector<size_t> row_; //meteo row of every sorted time
+    vector<int64_t> epoch_;
+    size_t pos_ = 0;
+};
+
+//find temperature relation
+int compare_temp(int64_t epoch_amb, MeteoIndex &meteo_index, int64_t tolerance)
+{
+    return meteo_index.nearest(epoch_amb, tolerance);
 };
 
 //correlate meteo and ambient data
-void getMeteo_amb(Data &data_amb, Data &data_meteo, Data &data_meteo_amb)
+//ambient points without meteo data within tolerance seconds are left out of both outputs,
+//temp_amb of data_amb gets the ventilated temperature of every point (NaN without meteo data)
+void getMeteo_amb(Data &data_amb, Data &data_meteo, Data &data_amb_meteo, Data &data_meteo_amb, int64_t tolerance)
 {
-    int start = 0;
+    MeteoIndex meteo_index(data_meteo.epoch);
+    int missing = 0;
+    data_amb.temp_amb.assign(data_amb.timed.size(), numeric_limits<double>::quiet_NaN());
     for(int i = 0; i < data_amb.timed.size(); i++)
     {
-        start = compare_temp(data_amb.timed[i], data_meteo.interval, start);
+        int start = compare_temp(data_amb.epoch[i], meteo_index, tolerance);
+        if (start < 0){missing++; continue;};
+        data_amb.temp_amb[i] = data_meteo.ventemp[start];
+        data_amb_meteo.timed.push_back(data_amb.timed[i]);
+        data_amb_meteo.date.push_back(data_amb.date[i]);
+        data_amb_meteo.epoch.push_back(data_amb.epoch[i]);
+        data_amb_meteo.H2O.push_back(data_amb.H2O[i]);
+        data_amb_meteo.O18.push_back(data_amb.O18[i]);
+        data_amb_meteo.H2.push_back(data_amb.H2[i]);
+        data_amb_meteo.Dexcess.push_back(data_amb.Dexcess[i]);
+        data_amb_meteo.hour.push_back(data_amb.hour[i]);
+        data_amb_meteo.month.push_back(data_amb.month[i]);
+        data_amb_meteo.season.push_back(data_amb.season[i]);
+
         data_meteo_amb.timed.push_back(data_meteo.timed[start]);
+        data_meteo_amb.epoch.push_back(data_meteo.epoch[start]);
         data_meteo_amb.interval.push_back(data_meteo.interval[start]);
         data_meteo_amb.windvel.push_back(data_meteo.windvel[start]);
         data_meteo_amb.contemp.push_back(data_meteo.contemp[start]);
@@ -286,6 +414,17 @@ void getMeteo_amb(Data &data_amb, Data &data_meteo, Data &data_meteo_amb)
     };
     cout << "Size of data Meteo: " << data_meteo_amb.timed.size() << endl;
     cout << "Size of data amb: " << data_amb.timed.size() << endl;
+    cout << "No meteo data within " << tolerance << " s: " << missing << endl;
+    stage_report.count("join", "matched", data_amb_meteo.timed.size());
+    stage_report.count("join", "misses", missing);
+};
+
+//scatter graph with about one point per marker of the pad, see decimate.h
+TGraph *scatterGraph(vector<double> &x, vector<double> &y, int pad_width, int pad_height)
+{
+    vector<double> px, py;
+    decimateDensity(x.data(), y.data(), x.size() < y.size() ? x.size() : y.size(), pad_width/4, pad_height/4, px, py);
+    return new TGraph(px.size(), px.data(), py.data());
 };
 
 //draw Graphs
@@ -353,13 +492,13 @@ void drawGraphs(Data &data_amb, Data &data_meteo, string evalpath, string year)
     cO18->SetGrid();
     cO18->cd();
 
-    grO18.push_back(new TGraph(data_amb.O18.size(), data_amb.O18.data(), data_meteo.windvel.data()));
-    grO18.push_back(new TGraph(data_amb.O18.size(), data_amb.O18.data(), data_meteo.contemp.data()));
-    grO18.push_back(new TGraph(data_amb.O18.size(), data_amb.O18.data(), data_meteo.rh1.data()));
-    grO18.push_back(new TGraph(data_amb.O18.size(), data_amb.O18.data(), data_meteo.rh2.data()));
-    grO18.push_back(new TGraph(data_amb.O18.size(), data_amb.O18.data(), data_meteo.ventemp.data()));
-    grO18.push_back(new TGraph(data_amb.O18.size(), data_amb.O18.data(), data_meteo.winddir.data()));
-    grO18.push_back(new TGraph(data_amb.O18.size(), data_amb.O18.data(), data_meteo.grad.data()));
+    grO18.push_back(scatterGraph(data_amb.O18, data_meteo.windvel, width/3, height));
+    grO18.push_back(scatterGraph(data_amb.O18, data_meteo.contemp, width/3, height));
+    grO18.push_back(scatterGraph(data_amb.O18, data_meteo.rh1, width/3, height));
+    grO18.push_back(scatterGraph(data_amb.O18, data_meteo.rh2, width/3, height));
+    grO18.push_back(scatterGraph(data_amb.O18, data_meteo.ventemp, width/3, height));
+    grO18.push_back(scatterGraph(data_amb.O18, data_meteo.winddir, width/3, height));
+    grO18.push_back(scatterGraph(data_amb.O18, data_meteo.grad, width/3, height));
 
     for(int i = 0; i < grO18.size(); i++)
     {
@@ -384,13 +523,13 @@ void drawGraphs(Data &data_amb, Data &data_meteo, string evalpath, string year)
     cH2->SetGrid();
     cH2->cd();
 
-    grH2.push_back(new TGraph(data_amb.H2.size(), data_amb.H2.data(), data_meteo.windvel.data()));
-    grH2.push_back(new TGraph(data_amb.H2.size(), data_amb.H2.data(), data_meteo.contemp.data()));
-    grH2.push_back(new TGraph(data_amb.H2.size(), data_amb.H2.data(), data_meteo.rh1.data()));
-    grH2.push_back(new TGraph(data_amb.H2.size(), data_amb.H2.data(), data_meteo.rh2.data()));
-    grH2.push_back(new TGraph(data_amb.H2.size(), data_amb.H2.data(), data_meteo.ventemp.data()));
-    grH2.push_back(new TGraph(data_amb.H2.size(), data_amb.H2.data(), data_meteo.winddir.data()));
-    grH2.push_back(new TGraph(data_amb.H2.size(), data_amb.H2.data(), data_meteo.grad.data()));
+    grH2.push_back(scatterGraph(data_amb.H2, data_meteo.windvel, width/3, height));
+    grH2.push_back(scatterGraph(data_amb.H2, data_meteo.contemp, width/3, height));
+    grH2.push_back(scatterGraph(data_amb.H2, data_meteo.rh1, width/3, height));
+    grH2.push_back(scatterGraph(data_amb.H2, data_meteo.rh2, width/3, height));
+    grH2.push_back(scatterGraph(data_amb.H2, data_meteo.ventemp, width/3, height));
+    grH2.push_back(scatterGraph(data_amb.H2, data_meteo.winddir, width/3, height));
+    grH2.push_back(scatterGraph(data_amb.H2, data_meteo.grad, width/3, height));
 
     for(int i = 0; i < grH2.size(); i++)
     {
@@ -418,13 +557,13 @@ void drawGraphs(Data &data_amb, Data &data_meteo, string evalpath, string year)
     cDex->SetGrid();
     cDex->cd();
 
-    grDex.push_back(new TGraph(data_amb.Dexcess.size(), data_amb.Dexcess.data(), data_meteo.windvel.data()));
-    grDex.push_back(new TGraph(data_amb.Dexcess.size(), data_amb.Dexcess.data(), data_meteo.contemp.data()));
-    grDex.push_back(new TGraph(data_amb.Dexcess.size(), data_amb.Dexcess.data(), data_meteo.rh1.data()));
-    grDex.push_back(new TGraph(data_amb.Dexcess.size(), data_amb.Dexcess.data(), data_meteo.rh2.data()));
-    grDex.push_back(new TGraph(data_amb.Dexcess.size(), data_amb.Dexcess.data(), data_meteo.ventemp.data()));
-    grDex.push_back(new TGraph(data_amb.Dexcess.size(), data_amb.Dexcess.data(), data_meteo.winddir.data()));
-    grDex.push_back(new TGraph(data_amb.Dexcess.size(), data_amb.Dexcess.data(), data_meteo.grad.data()));
+    grDex.push_back(scatterGraph(data_amb.Dexcess, data_meteo.windvel, width/3, height));
+    grDex.push_back(scatterGraph(data_amb.Dexcess, data_meteo.contemp, width/3, height));
+    grDex.push_back(scatterGraph(data_amb.Dexcess, data_meteo.rh1, width/3, height));
+    grDex.push_back(scatterGraph(data_amb.Dexcess, data_meteo.rh2, width/3, height));
+    grDex.push_back(scatterGraph(data_amb.Dexcess, data_meteo.ventemp, width/3, height));
+    grDex.push_back(scatterGraph(data_amb.Dexcess, data_meteo.winddir, width/3, height));
+    grDex.push_back(scatterGraph(data_amb.Dexcess, data_meteo.grad, width/3, height));
 
     for(int i = 0; i < grDex.size(); i++)
     {
@@ -459,67 +598,40 @@ void writeData(Data &data_amb, Data &data_meteo, string evalpath, string year)
 };
 
 //draw Diurnal Graphs
-void drawGraphDiurnal(Data &data_amb, string evalpath, string year)
+void drawGraphDiurnal(RollupCache &rollup, string evalpath, string year)
 {
-    vector<vector<double>> O18,H2,Dex;
     vector<double> yO18,yH2,yDex,hour;
     vector<double> yO18_err,yH2_err,yDex_err,hour_err;
+    //hour of day x month summed over the months
+    vector<vector<RollupCell>> cells = rollup.hourOfDay();
     for(int i = 0; i < 24; i++)
     {
+        const RollupCell &O18 = cells[i][rollup_O18];
+        const RollupCell &H2 = cells[i][rollup_H2];
+        const RollupCell &Dex = cells[i][rollup_Dex];
         hour.push_back(i);
         hour_err.push_back(0.);
-        O18.push_back(vector<double>());
-        H2.push_back(vector<double>());
-        Dex.push_back(vector<double>());
-    }
-    for(int i = 0; i < data_amb.timed.size(); i++)
-    {
-        if(data_amb.hour[i] == "00"){O18[0].push_back(data_amb.O18[i]);H2[0].push_back(data_amb.H2[i]);Dex[0].push_back(data_amb.Dexcess[i]);};
-        if(data_amb.hour[i] == "01"){O18[1].push_back(data_amb.O18[i]);H2[1].push_back(data_amb.H2[i]);Dex[1].push_back(data_amb.Dexcess[i]);};
-        if(data_amb.hour[i] == "02"){O18[2].push_back(data_amb.O18[i]);H2[2].push_back(data_amb.H2[i]);Dex[2].push_back(data_amb.Dexcess[i]);};
-        if(data_amb.hour[i] == "03"){O18[3].push_back(data_amb.O18[i]);H2[3].push_back(data_amb.H2[i]);Dex[3].push_back(data_amb.Dexcess[i]);};
-        if(data_amb.hour[i] == "04"){O18[4].push_back(data_amb.O18[i]);H2[4].push_back(data_amb.H2[i]);Dex[4].push_back(data_amb.Dexcess[i]);};
-        if(data_amb.hour[i] == "05"){O18[5].push_back(data_amb.O18[i]);H2[5].push_back(data_amb.H2[i]);Dex[5].push_back(data_amb.Dexcess[i]);};
-        if(data_amb.hour[i] == "06"){O18[6].push_back(data_amb.O18[i]);H2[6].push_back(data_amb.H2[i]);Dex[6].push_back(data_amb.Dexcess[i]);};
-        if(data_amb.hour[i] == "07"){O18[7].push_back(data_amb.O18[i]);H2[7].push_back(data_amb.H2[i]);Dex[7].push_back(data_amb.Dexcess[i]);};
-        if(data_amb.hour[i] == "08"){O18[8].push_back(data_amb.O18[i]);H2[8].push_back(data_amb.H2[i]);Dex[8].push_back(data_amb.Dexcess[i]);};
-        if(data_amb.hour[i] == "09"){O18[9].push_back(data_amb.O18[i]);H2[9].push_back(data_amb.H2[i]);Dex[9].push_back(data_amb.Dexcess[i]);};
-        if(data_amb.hour[i] == "10"){O18[10].push_back(data_amb.O18[i]);H2[10].push_back(data_amb.H2[i]);Dex[10].push_back(data_amb.Dexcess[i]);};
-        if(data_amb.hour[i] == "11"){O18[11].push_back(data_amb.O18[i]);H2[11].push_back(data_amb.H2[i]);Dex[11].push_back(data_amb.Dexcess[i]);};
-        if(data_amb.hour[i] == "12"){O18[12].push_back(data_amb.O18[i]);H2[12].push_back(data_amb.H2[i]);Dex[12].push_back(data_amb.Dexcess[i]);};
-        if(data_amb.hour[i] == "13"){O18[13].push_back(data_amb.O18[i]);H2[13].push_back(data_amb.H2[i]);Dex[13].push_back(data_amb.Dexcess[i]);};
-        if(data_amb.hour[i] == "14"){O18[14].push_back(data_amb.O18[i]);H2[14].push_back(data_amb.H2[i]);Dex[14].push_back(data_amb.Dexcess[i]);};
-        if(data_amb.hour[i] == "15"){O18[15].push_back(data_amb.O18[i]);H2[15].push_back(data_amb.H2[i]);Dex[15].push_back(data_amb.Dexcess[i]);};
-        if(data_amb.hour[i] == "16"){O18[16].push_back(data_amb.O18[i]);H2[16].push_back(data_amb.H2[i]);Dex[16].push_back(data_amb.Dexcess[i]);};
-        if(data_amb.hour[i] == "17"){O18[17].push_back(data_amb.O18[i]);H2[17].push_back(data_amb.H2[i]);Dex[17].push_back(data_amb.Dexcess[i]);};
-        if(data_amb.hour[i] == "18"){O18[18].push_back(data_amb.O18[i]);H2[18].push_back(data_amb.H2[i]);Dex[18].push_back(data_amb.Dexcess[i]);};
-        if(data_amb.hour[i] == "19"){O18[19].push_back(data_amb.O18[i]);H2[19].push_back(data_amb.H2[i]);Dex[19].push_back(data_amb.Dexcess[i]);};
-        if(data_amb.hour[i] == "20"){O18[20].push_back(data_amb.O18[i]);H2[20].push_back(data_amb.H2[i]);Dex[20].push_back(data_amb.Dexcess[i]);};
-        if(data_amb.hour[i] == "21"){O18[21].push_back(data_amb.O18[i]);H2[21].push_back(data_amb.H2[i]);Dex[21].push_back(data_amb.Dexcess[i]);};
-        if(data_amb.hour[i] == "22"){O18[22].push_back(data_amb.O18[i]);H2[22].push_back(data_amb.H2[i]);Dex[22].push_back(data_amb.Dexcess[i]);};
-        if(data_amb.hour[i] == "23"){O18[23].push_back(data_amb.O18[i]);H2[23].push_back(data_amb.H2[i]);Dex[23].push_back(data_amb.Dexcess[i]);};
-    };
-    for(int i = 0; i < 24; i++)
-    {
-        yO18.push_back(TMath::Mean(O18[i].begin(),O18[i].end()));
-        yH2.push_back(TMath::Mean(H2[i].begin(),H2[i].end()));
-        yDex.push_back(TMath::Mean(Dex[i].begin(),Dex[i].end()));
-        yO18_err.push_back(TMath::StdDev(O18[i].begin(),O18[i].end())/(O18[i].size()-1));
-        yH2_err.push_back(TMath::StdDev(H2[i].begin(),H2[i].end())/(H2[i].size()-1));
-        yDex_err.push_back(TMath::StdDev(Dex[i].begin(),Dex[i].end())/(Dex[i].size()-1));
+        yO18.push_back(O18.mean());
+        yH2.push_back(H2.mean());
+        yDex.push_back(Dex.mean());
+        yO18_err.push_back(O18.stdev()/(O18.count-1));
+        yH2_err.push_back(H2.stdev()/(H2.count-1));
+        yDex_err.push_back(Dex.stdev()/(Dex.count-1));
 
         cout << "Data mean||STDEV for O18 at " << i << ":" << yO18[i] << "||" << yO18_err[i] << endl;
         cout << "Data mean||STDEV for H2 at " << i << ":" << yH2[i] << "||" << yH2_err[i] << endl;
         cout << "Data mean||STDEV for Dex at " << i << ":" << yDex[i] << "||" << yDex_err[i] << endl;
     };
-    double mean_O18, mean_H2, mean_Dex;
-    double mean_O18_err, mean_H2_err, mean_Dex_err;
-    mean_O18 = TMath::Mean(yO18.begin(),yO18.end());
-    mean_H2 = TMath::Mean(yH2.begin(),yH2.end());
-    mean_Dex = TMath::Mean(yDex.begin(),yDex.end());
-    mean_O18_err = TMath::StdDev(yO18.begin(),yO18.end());
-    mean_H2_err = TMath::StdDev(yH2.begin(),yH2.end());
-    mean_Dex_err = TMath::StdDev(yDex.begin(),yDex.end());
+    //level of the day from the 24 hourly means, hours without samples (NaN) are left out
+    RunningStats day_O18, day_H2, day_Dex;
+    for(int i = 0; i < 24; i++)
+    {
+        if (std::isfinite(yO18[i])){day_O18.add(yO18[i]);};
+        if (std::isfinite(yH2[i])){day_H2.add(yH2[i]);};
+        if (std::isfinite(yDex[i])){day_Dex.add(yDex[i]);};
+    };
+    double mean_O18 = day_O18.average(), mean_H2 = day_H2.average(), mean_Dex = day_Dex.average();
+    double mean_O18_err = day_O18.stdev(), mean_H2_err = day_H2.stdev(), mean_Dex_err = day_Dex.stdev();
 
     double x,xerr;
     for(int i = 0; i < 24; i++)
@@ -596,7 +708,7 @@ void drawGraphDiurnal(Data &data_amb, string evalpath, string year)
 void drawGraphSeason(Data &data_amb, Data &data_meteo, string evalpath, string year)
 {
     //preparing vectors
-    vector<vector<double>> xO18, yH2, temp, time;
+    vector<vector<double>> xO18, yH2;
     vector<string> Title, tempTitle;
     double max_O18, min_O18;
     double max_H2, min_H2;
@@ -616,8 +728,6 @@ void drawGraphSeason(Data &data_amb, Data &data_meteo, string evalpath, string y
     {
         xO18.push_back(vector<double>());
         yH2.push_back(vector<double>());
-        temp.push_back(vector<double>());
-        time.push_back(vector<double>());
         if(i == 0){Title.push_back(year + " Winter LMWL Ambient;#delta^{18}O;#delta^{2}H");};
         if(i == 1){Title.push_back(year + " Spring LMWL Ambient;#delta^{18}O;#delta^{2}H");};
         if(i == 2){Title.push_back(year + " Summer LMWL Ambient;#delta^{18}O;#delta^{2}H");};
@@ -629,62 +739,17 @@ void drawGraphSeason(Data &data_amb, Data &data_meteo, string evalpath, string y
         fitname.push_back("f" + i);
         linFit.push_back(new TF1(fitname[i].c_str(),"pol1",min_O18,max_O18));
     };
-    for(int i = 0; i < data_amb.timed.size(); i++)
-    {
-        if(data_amb.month_str[i] == "01" || data_amb.month_str[i] == "02" || data_amb.month_str[i] == "12")
-        {
-            xO18[0].push_back(data_amb.O18[i]);
-            yH2[0].push_back(data_amb.H2[i]);
-        };
-
-        if(data_amb.month_str[i] == "03" || data_amb.month_str[i] == "04" || data_amb.month_str[i] == "05")
-        {
-            xO18[1].push_back(data_amb.O18[i]);
-            yH2[1].push_back(data_amb.H2[i]);
-        };
-
-        if(data_amb.month_str[i] == "06" || data_amb.month_str[i] == "07" || data_amb.month_str[i] == "08")
-        {
-            xO18[2].push_back(data_amb.O18[i]);
-            yH2[2].push_back(data_amb.H2[i]);
-        };
-
-        if(data_amb.month_str[i] == "09" || data_amb.month_str[i] == "10" || data_amb.month_str[i] == "11")
-        {
-            xO18[3].push_back(data_amb.O18[i]);
-            yH2[3].push_back(data_amb.H2[i]);
-        };
-    };
-    for(int i = 0; i < data_meteo.ventemp.size(); i++)
+    BucketIndex season_amb(data_amb.season, 4);
+    for(int i = 0; i < 4; i++)
     {
-        if(data_meteo.month_str[i] == "01" || data_meteo.month_str[i] == "02" || data_meteo.month_str[i] == "12")
-        {
-            temp[0].push_back(data_meteo.ventemp[i]);
-            time[0].push_back(data_meteo.month[i]);
-        };
-
-        if(data_meteo.month_str[i] == "03" || data_meteo.month_str[i] == "04" || data_meteo.month_str[i] == "05")
-        {
-            temp[1].push_back(data_meteo.ventemp[i]);
-            time[1].push_back(data_meteo.month[i]);
-        };
-
-        if(data_meteo.month_str[i] == "06" || data_meteo.month_str[i] == "07" || data_meteo.month_str[i] == "08")
-        {
-            temp[2].push_back(data_meteo.ventemp[i]);
-            time[2].push_back(data_meteo.month[i]);
-        };
-
-        if(data_meteo.month_str[i] == "09" || data_meteo.month_str[i] == "10" || data_meteo.month_str[i] == "11")
-        {
-            temp[3].push_back(data_meteo.ventemp[i]);
-            time[3].push_back(data_meteo.month[i]);
-        };
+        season_amb.gather(i, data_amb.O18, xO18[i]);
+        season_amb.gather(i, data_amb.H2, yH2[i]);
     };
+    vector<RunningStats> temp = groupBy<RunningStats>(data_meteo.season, 4, data_meteo.ventemp, thread::hardware_concurrency());
     for(int i = 0; i < 4; i++)
     {
         cout << "Size of O18: " << i << "=" << xO18[i].size() << endl;
-        cout << "Size of temp: " << i << "=" << temp[i].size() << endl;
+        cout << "Size of temp: " << i << "=" << temp[i].count << endl;
     };
 
     //drawing
@@ -792,10 +857,10 @@ void drawGraphSeason(Data &data_amb, Data &data_meteo, string evalpath, string y
     cAll->Close();
 
     cout << "Mean Temperature w/s/s/a:";
-    cout << TMath::Mean(temp[0].begin(),temp[0].end()) << "/";
-    cout << TMath::Mean(temp[1].begin(),temp[1].end()) << "/";
-    cout << TMath::Mean(temp[2].begin(),temp[2].end()) << "/";
-    cout << TMath::Mean(temp[3].begin(),temp[3].end()) << endl;
+    cout << temp[0].average() << "/";
+    cout << temp[1].average() << "/";
+    cout << temp[2].average() << "/";
+    cout << temp[3].average() << endl;
 
 };
 
@@ -824,20 +889,12 @@ void drawGraphTemp(Data &data_amb, Data &data_meteo, string evalpath, string yea
     color.push_back(824); //spring+4 10
     color.push_back(845); //teal+5 11
     color.push_back(866); //azura+6 12
-    for(int i = 0; i < data_amb.O18.size(); i++)
+    //months 1..12, bucket 0 stays empty
+    BucketIndex month_amb(data_amb.month, 13);
+    for(int i = 0; i < 12; i++)
     {
-        if(data_amb.month_str[i] == "01"){xO18[0].push_back(data_amb.O18[i]);yTemp[0].push_back(data_meteo.ventemp[i]);};
-        if(data_amb.month_str[i] == "02"){xO18[1].push_back(data_amb.O18[i]);yTemp[1].push_back(data_meteo.ventemp[i]);};
-        if(data_amb.month_str[i] == "03"){xO18[2].push_back(data_amb.O18[i]);yTemp[2].push_back(data_meteo.ventemp[i]);};
-        if(data_amb.month_str[i] == "04"){xO18[3].push_back(data_amb.O18[i]);yTemp[3].push_back(data_meteo.ventemp[i]);};
-        if(data_amb.month_str[i] == "05"){xO18[4].push_back(data_amb.O18[i]);yTemp[4].push_back(data_meteo.ventemp[i]);};
-        if(data_amb.month_str[i] == "06"){xO18[5].push_back(data_amb.O18[i]);yTemp[5].push_back(data_meteo.ventemp[i]);};
-        if(data_amb.month_str[i] == "07"){xO18[6].push_back(data_amb.O18[i]);yTemp[6].push_back(data_meteo.ventemp[i]);};
-        if(data_amb.month_str[i] == "08"){xO18[7].push_back(data_amb.O18[i]);yTemp[7].push_back(data_meteo.ventemp[i]);};
-        if(data_amb.month_str[i] == "09"){xO18[8].push_back(data_amb.O18[i]);yTemp[8].push_back(data_meteo.ventemp[i]);};
-        if(data_amb.month_str[i] == "10"){xO18[9].push_back(data_amb.O18[i]);yTemp[9].push_back(data_meteo.ventemp[i]);};
-        if(data_amb.month_str[i] == "11"){xO18[10].push_back(data_amb.O18[i]);yTemp[10].push_back(data_meteo.ventemp[i]);};
-        if(data_amb.month_str[i] == "12"){xO18[11].push_back(data_amb.O18[i]);yTemp[11].push_back(data_meteo.ventemp[i]);};
+        month_amb.gather(i+1, data_amb.O18, xO18[i]);
+        month_amb.gather(i+1, data_meteo.ventemp, yTemp[i]);
     };
 
     TMultiGraph *mgO18 = new TMultiGraph();
@@ -861,7 +918,8 @@ void drawGraphTemp(Data &data_amb, Data &data_meteo, string evalpath, string yea
 };
 
 //draw monthly ambient
-void drawGraphMeanYear(Data &data_amb, Data &data_meteo, string evalpath, string year)
+//the temperature is the ventilated temperature at the ambient points that have meteo data
+void drawGraphMeanYear(RollupCache &rollup, string evalpath, string year)
 {
     string name_file = evalpath + "/End/" + year + "_mean_year.png";
 
@@ -872,42 +930,18 @@ void drawGraphMeanYear(Data &data_amb, Data &data_meteo, string evalpath, string
     TGraph *grO18, *grH2, *grTemp;
     vector<double> yO18, yH2, yTemp;
     vector<double> xMonth;
-    vector<double> O18, H2, Temp;
-    int month = 1;
-    if(year == "2019"){month = 4;};
-    if(year == "2018"){month = 4;};
 
-    for(int i = 0; i < data_amb.timed.size(); i++)
+    //only months with data
+    for (auto &item : rollup.level(rollup_month))
     {
-        if(stoi(data_amb.month_str[i]) > month)
-        {
-            yO18.push_back(TMath::Mean(O18.begin(),O18.end()));
-            yH2.push_back(TMath::Mean(H2.begin(),H2.end()));
-            yTemp.push_back(TMath::Mean(Temp.begin(),Temp.end()));
-            cout << "Size of month:" << month << "=" << O18.size() << "|" << H2.size() << "|" << Temp.size() << endl;
-            cout << "Size of month:" << month << "=" << yO18.size() << "|" << yH2.size() << "|" << yTemp.size() << endl;
-            O18.clear();
-            H2.clear();
-            Temp.clear();
-            xMonth.push_back(month);
-            month = stoi(data_amb.month_str[i]);
-        };
-        if(stoi(data_amb.month_str[i]) == month)
-        {
-            O18.push_back(data_amb.O18[i]);
-            H2.push_back(data_amb.H2[i]);
-            Temp.push_back(data_meteo.ventemp[i]);
-        };
+        const vector<RollupCell> &cell = item.second;
+        int month = RollupCache::monthOfKey(item.first);
+        xMonth.push_back(month);
+        yO18.push_back(cell[rollup_O18].mean());
+        yH2.push_back(cell[rollup_H2].mean());
+        yTemp.push_back(cell[rollup_temp].mean());
+        cout << "Size of month:" << month << "=" << cell[rollup_O18].count << "|" << cell[rollup_H2].count << "|" << cell[rollup_temp].count << endl;
     };
-    yO18.push_back(TMath::Mean(O18.begin(),O18.end()));
-    yH2.push_back(TMath::Mean(H2.begin(),H2.end()));
-    yTemp.push_back(TMath::Mean(Temp.begin(),Temp.end()));
-    cout << "Size of month:" << month << "=" << O18.size() << "|" << H2.size() << "|" << Temp.size() << endl;
-    cout << "Size of month:" << month << "=" << yO18.size() << "|" << yH2.size() << "|" << yTemp.size() << endl;
-    O18.clear();
-    H2.clear();
-    Temp.clear();
-    xMonth.push_back(month);
     grO18 = new TGraph(yO18.size(),xMonth.data(),yO18.data());
     grH2 = new TGraph(yH2.size(),xMonth.data(),yH2.data());
     grTemp = new TGraph(yTemp.size(),xMonth.data(),yTemp.data());
@@ -947,50 +981,152 @@ void drawGraphMeanYear(Data &data_amb, Data &data_meteo, string evalpath, string
     cAll->Close();
 };
 
+//rows of one year of ambient, meteo or joined data
+Data yearPart(Data &data, const vector<size_t> &rows)
+{
+    Data part;
+    part.timed = pickRows(data.timed, rows);
+    part.date = pickRows(data.date, rows);
+    part.epoch = pickRows(data.epoch, rows);
+    part.interval = pickRows(data.interval, rows);
+    part.O18 = pickRows(data.O18, rows);
+    part.H2 = pickRows(data.H2, rows);
+    part.Dexcess = pickRows(data.Dexcess, rows);
+    part.H2O = pickRows(data.H2O, rows);
+    part.temp_amb = pickRows(data.temp_amb, rows);
+    part.windvel = pickRows(data.windvel, rows);
+    part.contemp = pickRows(data.contemp, rows);
+    part.rh1 = pickRows(data.rh1, rows);
+    part.rh2 = pickRows(data.rh2, rows);
+    part.grad = pickRows(data.grad, rows);
+    part.apress = pickRows(data.apress, rows);
+    part.no = pickRows(data.no, rows);
+    part.ventemp = pickRows(data.ventemp, rows);
+    part.winddir = pickRows(data.winddir, rows);
+    part.prec = pickRows(data.prec, rows);
+    part.hour = pickRows(data.hour, rows);
+    part.month = pickRows(data.month, rows);
+    part.season = pickRows(data.season, rows);
+    return part;
+};
+
+//Graphs, output file and rollup cache of one year
+void evaluateYear(Data &data_amb, Data &data_meteo, Data &data_amb_meteo, Data &data_meteo_amb, string evalpath, string year, bool rebuild, RenderQueue &render)
+{
+    render.submit("overview " + year, [&]{drawGraphs(data_amb_meteo, data_meteo_amb, evalpath, year);});
+    {
+        auto timer = stage_report.time("write");
+        writeData(data_amb, data_meteo_amb, evalpath, year);
+    };
+
+    //hourly, daily and monthly sums, only new data is added
+    auto rollup_timer = stage_report.time("rollup");
+    RollupCache rollup(evalpath + "/End/Ambient_rollup_" + year + ".txt", rollup_channels, rebuild);
+    size_t added = rollup.update(data_amb.epoch, {&data_amb.O18, &data_amb.H2, &data_amb.Dexcess, &data_amb.H2O, &data_amb.temp_amb});
+    cout << "Rollup " << year << ": " << added << " new of " << rollup.rows() << " points" << endl;
+    if (!rollup.save()){cout << "Could not write rollup cache to " << evalpath << "/End" << endl;};
+    rollup_timer.stop();
+    stage_report.count("rollup", "points added", added);
+    stage_report.count("rollup", "points", rollup.rows());
+
+    //a worker sees the data as it is now, the rollup of the year can go after the jobs are submitted
+    render.submit("diurnal " + year, [&]{drawGraphDiurnal(rollup, evalpath, year);});
+    render.submit("season " + year, [&]{drawGraphSeason(data_amb, data_meteo, evalpath, year);});
+    render.submit("temperature " + year, [&]{drawGraphTemp(data_amb_meteo, data_meteo_amb, evalpath, year);});
+    render.submit("mean year " + year, [&]{drawGraphMeanYear(rollup, evalpath, year);});
+};
+
 int main(int argc, char* argv[])
 {
+    RunOptions options(argc, argv,
+        "  --year YEAR        year to evaluate\n"
+        "  --years FIRST-LAST all years of the range in one run, written per year\n"
+        "  --ambient FILE     Ambient_data_YEAR_corr.pcol or .txt of eval_air_std.cc\n"
+        "  --meteo FILE       meteo .dat file, several separated by commas\n"
+        "  --output DIR       folder for evaluation\n"
+        "  --tolerance SEC    largest time difference of meteo and ambient data (default 900)\n"
+        "  --rebuild          sum End/Ambient_rollup_YEAR.txt fresh\n"
+        "  --render N         figures drawn at the same time in worker processes (default all cores, 1 draws here)\n");
+    //largest time difference of meteo and ambient data in seconds
+    int64_t tolerance = options.number("tolerance", 900);
+    stage_report.setProgram("ambient_eval_meteo");
     //////////////////////////////////
     // Name, date and path to files //
     //////////////////////////////////
-    string year;
-    cout << "Which year?" << endl;
-    cin >> year;
-    char const * lFilterPatterns[1]={"*.txt"};
+    YearRange years = options.years();
+    string year = years.label();
+    char const * lFilterPatterns[2]={"*.pcol", "*.txt"};
     char const * lFilterPatterns1[1]={"*.dat"};
-    string datapath_amb = tinyfd_openFileDialog("Choose File with Ambient data", ".", 1, lFilterPatterns, NULL, 0);
+    string datapath_amb = options.openFile("ambient", "Choose File with Ambient data", 2, lFilterPatterns);
     cout << "Data Ambient file: " << datapath_amb << endl;
 
-    string datapath_meteo = tinyfd_openFileDialog("Choose File with Meteo data", ".", 1, lFilterPatterns1, NULL, 0);
+    string datapath_meteo = options.openFile("meteo", "Choose File with Meteo data", 1, lFilterPatterns1);
+    //the meteo files of a range in time order (Meteo_YYYY_...)
+    vector<string> files_meteo = options.has("meteo") ? options.list("meteo") : vector<string>{datapath_meteo};
+    sort(files_meteo.begin(), files_meteo.end());
     cout << "Data Meteo file: " << datapath_meteo << endl;
 
     //choose directory for evaluation data
-    string evalpath = tinyfd_selectFolderDialog("Choose Folder for Evaluation", ".");
+    string evalpath = options.selectFolder("output", "Choose Folder for Evaluation");
     cout << "Evalpath " << evalpath << endl;
+    stage_report.info("year", year);
+    stage_report.info("ambient", datapath_amb);
+    stage_report.info("meteo", datapath_meteo);
 
     //////////////////////////////////////////////////
     // Read files and store values //
     //////////////////////////////////////////////////
-    Data data_amb, data_meteo, data_meteo_amb;
+    Data data_amb, data_meteo, data_amb_meteo, data_meteo_amb;
 
     cout << "################" << endl << "Reading Meteo data ..." << endl;
-    getData_meteo(datapath_meteo, data_meteo);
+    {
+        auto timer = stage_report.time("read meteo");
+        for (size_t i = 0; i < files_meteo.size(); i++){getData_meteo(files_meteo[i], data_meteo);};
+        stage_report.count("read meteo", "files", files_meteo.size());
+    };
     cout << "Finished." << endl << "################" << endl << "Reading Ambient Air data ..." << endl;
-    getData_amb(datapath_amb, data_amb, year);
+    {
+        auto timer = stage_report.time("read ambient");
+        getData_amb(datapath_amb, data_amb, years);
+    };
     cout << "Finished." << endl;
     cout << "################" << endl << "Comparing meteo and ambient ... " << endl;
 
-    getMeteo_amb(data_amb, data_meteo, data_meteo_amb);
+    {
+        auto timer = stage_report.time("join");
+        getMeteo_amb(data_amb, data_meteo, data_amb_meteo, data_meteo_amb, tolerance);
+    };
     cout << "Finished." << endl;
     cout << "################" << endl << "Drawing Graphs ... " << endl;
-    drawGraphs(data_amb, data_meteo_amb, evalpath, year);
+    //figures are drawn in the background while the program goes on,
+    //draw is the time until the last one is done
+    auto draw_timer = stage_report.time("draw");
+    RenderQueue render(options.number("render", 0));
+    if (render.workers() > 1){gROOT->SetBatch(kTRUE);};
+    if (years.single()){evaluateYear(data_amb, data_meteo, data_amb_meteo, data_meteo_amb, evalpath, year, options.flag("rebuild"), render);}
+    else
+    {
+        //read once, split into the years for the output
+        map<int, vector<size_t>> rows_amb = rowsByYear(data_amb.timed, years);
+        map<int, vector<size_t>> rows_meteo = rowsByYear(data_meteo.timed, years);
+        map<int, vector<size_t>> rows_joined = rowsByYear(data_amb_meteo.timed, years);
+        for (int y : years.list())
+        {
+            Data part_amb = yearPart(data_amb, rows_amb[y]);
+            Data part_meteo = yearPart(data_meteo, rows_meteo[y]);
+            Data part_amb_meteo = yearPart(data_amb_meteo, rows_joined[y]);
+            Data part_meteo_amb = yearPart(data_meteo_amb, rows_joined[y]);
+            cout << "Year " << y << ": " << part_amb.timed.size() << " ambient points, " << part_amb_meteo.timed.size() << " with meteo data" << endl;
+            if (part_amb.timed.empty()){continue;};
+            evaluateYear(part_amb, part_meteo, part_amb_meteo, part_meteo_amb, evalpath, to_string(y), options.flag("rebuild"), render);
+        };
+    };
+    render.wait();
+    draw_timer.stop();
+    stage_report.count("draw", "figures", render.submitted());
     cout << "Finished." << endl;
-    cout << "################" << endl;
-    writeData(data_amb, data_meteo_amb, evalpath, year);
-
-    drawGraphDiurnal(data_amb, evalpath, year);
-    drawGraphSeason(data_amb, data_meteo, evalpath, year);
-    drawGraphTemp(data_amb, data_meteo_amb, evalpath, year);
-    drawGraphMeanYear(data_amb, data_meteo_amb, evalpath, year);
+    logger.summary();
+    stage_report.write(options.get("report", evalpath + "/End/Ambient_meteo_" + year + "_report"));
 
 
     return 0;
@@ -0,0 +1,762 @@
+////////////////////////////////////////////////////////////////////////////
+// Programm for benchmarking the readers of the Picarro L-2130i tools     //
+// author: Sebastian Stezura // E-Mail: sebastian_stezura@gmx.net         //
+// GitHub: CplusplusB                                                     //
+// version: 1 // date: 17.10.2026                                         //
+////////////////////////////////////////////////////////////////////////////
+
+//time the old getline/stringstream reading against the mapped reader
+//usage: ./Benchmark.o reader FILE.csv [FILE.csv ...]
+//for a multi-GB year pass all csv files of the year, they are read one after another
+//time the old substr/stoi timestamp parsing against the decoder of picarro_time.h
+//usage: ./Benchmark.o time [N]
+//time the Standard lookup of memcorr_amb, linear scans against the merge join of calibration.h
+//usage: ./Benchmark.o calib [YEARS] [STANDARDS]
+//time the scalar 60 sample averaging of meanXminData against the kernel of mean_kernel.h, blocks and sliding
+//usage: ./Benchmark.o mean [N]
+//time the string compares of drawGraphDiurnal/drawGraphSeason against the byte keys of bucket_index.h
+//usage: ./Benchmark.o group [N]
+//time the decimation of decimate.h and count the points left for a 4000 px wide pad
+//usage: ./Benchmark.o decimate [N]
+//write a synthetic data set (Picarro csv, meteo .dat, rain samples) of DAYS days from YYYYMMDD, see synthetic_data.h
+//usage: ./Benchmark.o generate DIR [DAYS] [YYYYMMDD] [INTERVAL]
+//run all programs in batch mode on a data set of generate and print the stage times of their reports,
+//the compiled programs (Ambient.o, Standards_eval_corr.o, ...) are looked for in BINDIR (default .)
+//  ambient             parse: getData                  standards_eval_corr  parse: getData
+//  eval_air_std        read standards: getData_std     read ambient: getData_amb
+//                      average: meanXminData           memcorr: memcorr_amb
+//  ambient_eval_meteo  read meteo: getData_meteo       read ambient: getData_amb    join: getMeteo_amb
+//  rainwater_eval      read samples: getFlask, getEvent, getMonth (with all meteo files of the data set)
+//usage: ./Benchmark.o pipeline DIR YEAR [BINDIR]
+
+////////////////////////////////////////////////////////////////////////////
+// compile command:                                                       //
+// g++-10 benchmark.cc -O2 -std=c++17 -o ./Benchmark.o                    //
+////////////////////////////////////////////////////////////////////////////
+
+//shared reader for Picarro csv files
+#include "picarro_reader.h"
+//timestamp decoder
+#include "picarro_time.h"
+//Standard lookup for calibration
+#include "calibration.h"
+//window means
+#include "mean_kernel.h"
+//grouping by hour and season
+#include "bucket_index.h"
+//accumulator for the groups
+#include "rollup.h"
+//fewer points for the graphs
+#include "decimate.h"
+//synthetic input files
+#include "synthetic_data.h"
+
+////////////////////
+// C/C++ includes //
+////////////////////
+#include <iostream> //for Input/Output functions
+#include <string> //for using strings
+#include <vector> //for using vectors
+#include <fstream> //for reading and writing to files
+#include <sstream> //for reading files
+#include <algorithm> //for different C/C++ functions
+#include <numeric> //for accumulate
+#include <cmath> //for sin
+#include <chrono> //for timing
+#include <iomanip> //for output format
+#include <cstdlib> //for system
+#include <filesystem> //for the data set folders
+
+using namespace std;
+
+//result of one benchmark run
+struct BenchResult
+{
+    string name;
+    double seconds = 0.;
+    double bytes = 0.;
+    long rows = 0;
+    double checksum = 0.;
+    double magnitude = 0.; //sum of the absolute values in the checksum, scale for comparing checksums
+};
+
+//print result line
+void printResult(BenchResult &res)
+{
+    cout << fixed << setprecision(3) << setw(24) << left << res.name << right
+         << " time " << setw(9) << res.seconds << " s"
+         << " | " << setw(9) << res.bytes/1e6/res.seconds << " MB/s"
+         << " | " << setw(12) << res.rows/res.seconds << " rows/s"
+         << " | rows " << res.rows << " | checksum " << res.checksum << endl;
+};
+
+//old way of ambient.cc getData, getline into 38 strings per row
+void legacyReader(vector<string> &files, BenchResult &res)
+{
+    string line_r, analysis_r, time_code_r, port_r, inj_nmb_r, O18w_r, H2w_r, H2Ow_mean_r, ignore_r, good_r, O18v_r, H2v_r, H2Ov_mean_r, identifier1_r, identifier2_r, gas_conf_r, time_mean_r, O18_sd_r, H2_sd_r, H2O_sd_r, O18_sl_r, H2_sl_r, H2O_sl_r, base_shift_r, slope_r, res_r, base_curv_r, interval_r, CH4_r, H2O_adj_r, H2O_shift_r, n2_r, temp_r, tray_r, sample_r, job_r, method_r, error_r;
+    auto start = chrono::steady_clock::now();
+    for (int f = 0; f < files.size(); f++)
+    {
+        ifstream inFile (files[f]);
+        string line;
+        int i = 0;
+        while (getline(inFile, line))
+        {
+            res.bytes += line.size()+1;
+            remove(line.begin(), line.end(), ' ');
+            stringstream stst(line);
+            getline(stst,line_r,',');
+            getline(stst,analysis_r,',');
+            getline(stst,time_code_r,',');
+            getline(stst,port_r,',');
+            getline(stst,inj_nmb_r,',');
+            getline(stst,O18w_r,',');
+            getline(stst,H2w_r,',');
+            getline(stst,H2Ow_mean_r,',');
+            getline(stst,ignore_r,',');
+            getline(stst,good_r,',');
+            getline(stst,O18v_r,',');
+            getline(stst,H2v_r,',');
+            getline(stst,H2Ov_mean_r,',');
+            getline(stst,identifier1_r,',');
+            getline(stst,identifier2_r,',');
+            getline(stst,gas_conf_r,',');
+            getline(stst,time_mean_r,',');
+            getline(stst,O18_sd_r,',');
+            getline(stst,H2_sd_r,',');
+            getline(stst,H2O_sd_r,',');
+            getline(stst,O18_sl_r,',');
+            getline(stst,H2_sl_r,',');
+            getline(stst,H2O_sl_r,',');
+            getline(stst,base_shift_r,',');
+            getline(stst,slope_r,',');
+            getline(stst,res_r,',');
+            getline(stst,base_curv_r,',');
+            getline(stst,interval_r,',');
+            getline(stst,CH4_r,',');
+            getline(stst,H2O_adj_r,',');
+            getline(stst,H2O_shift_r,',');
+            getline(stst,n2_r,',');
+            getline(stst,temp_r,',');
+            getline(stst,tray_r,',');
+            getline(stst,sample_r,',');
+            getline(stst,job_r,',');
+            getline(stst,method_r,',');
+            getline(stst,error_r,',');
+
+            remove(time_code_r.begin(), time_code_r.end(), '/');
+            remove(time_code_r.begin(), time_code_r.end(), ':');
+            for (int j = 0; j < 4; j++) {if (!time_code_r.empty()) {time_code_r.pop_back();};};
+
+            if (i == 0) {i = 1; continue;};
+            res.rows++;
+            try
+            {
+                if(port_r == "Ambient")
+                {
+                    res.checksum += stod(O18v_r) + stod(H2v_r) + stod(H2Ov_mean_r)*1e-4;
+                };
+            }
+            catch (...)
+            {
+            }
+        };
+    };
+    res.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+};
+
+//mapped reader, fields are views into the file
+void mappedReader(vector<string> &files, BenchResult &res)
+{
+    string_view field[picarro_columns];
+    string time_code_r;
+    double O18r, H2r, H2Or;
+    auto start = chrono::steady_clock::now();
+    for (int f = 0; f < files.size(); f++)
+    {
+        MappedFile inFile (files[f]);
+        res.bytes += inFile.size();
+        string_view text = inFile.view();
+        string_view line;
+        int i = 0;
+        while (nextLine(text, line))
+        {
+            splitFields(line, ',', field, picarro_columns);
+            formatTimeCode(field[col_time_code], time_code_r);
+            if (i == 0) {i = 1; continue;};
+            res.rows++;
+            if (field[col_port] == "Ambient" && parseDouble(field[col_O18v], O18r) && parseDouble(field[col_H2v], H2r) && parseDouble(field[col_H2Ov_mean], H2Or))
+            {
+                res.checksum += O18r + H2r + H2Or*1e-4;
+            };
+        };
+    };
+    res.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+};
+
+//compare both readers on the same files
+void benchReader(vector<string> &files)
+{
+    BenchResult legacy, mapped;
+    legacy.name = "getline/stringstream";
+    mapped.name = "mapped string_view";
+    //touch all pages once so both runs see a warm page cache
+    long touched = 0;
+    for (int f = 0; f < files.size(); f++)
+    {
+        MappedFile warm (files[f]);
+        string_view text = warm.view();
+        for (size_t j = 0; j < text.size(); j += 4096){touched += text[j];};
+    };
+    if (touched == 1){cout << endl;};
+
+    legacyReader(files, legacy);
+    printResult(legacy);
+    mappedReader(files, mapped);
+    printResult(mapped);
+    cout << "Speed-up: " << legacy.seconds/mapped.seconds << "x" << endl;
+};
+
+//timestamps of the Picarro ("YYYY/MM/DD HH:MM:SS.sss") and the meteo files ("YYYY-MM-DD HH:MM:SS")
+void makeTimestamps(long n, vector<string> &picarro, vector<string> &meteo)
+{
+    char buf[32];
+    int year, month, day, hour, min, sec;
+    for (long i = 0; i < n; i++)
+    {
+        civilFromEpoch(1514764800 + i*7, year, month, day, hour, min, sec); //from 2018
+        snprintf(buf, sizeof(buf), "%04d/%02d/%02d %02d:%02d:%02d.%03d", year, month, day, hour, min, sec, int(i%1000));
+        picarro.push_back(buf);
+        snprintf(buf, sizeof(buf), "%04d-%02d-%02d %02d:%02d:%02d", year, month, day, hour, min, sec);
+        meteo.push_back(buf);
+    };
+};
+
+//old way of the readers, strip separators and six stoi of substrings
+void legacyTime(vector<string> &picarro, vector<string> &meteo, BenchResult &res)
+{
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < picarro.size(); i++)
+    {
+        string time_code_r = picarro[i];
+        remove(time_code_r.begin(), time_code_r.end(), ' ');
+        remove(time_code_r.begin(), time_code_r.end(), '/');
+        remove(time_code_r.begin(), time_code_r.end(), ':');
+        for (int j = 0; j < 4; j++) {if (!time_code_r.empty()) {time_code_r.pop_back();};};
+        try
+        {
+            res.checksum += epochFromParts(stoi(time_code_r.substr(0,4)), stoi(time_code_r.substr(4,2)), stoi(time_code_r.substr(6,2)), stoi(time_code_r.substr(8,2)), stoi(time_code_r.substr(10,2)), stoi(time_code_r.substr(12,2)));
+        }
+        catch (...)
+        {
+        }
+
+        string interval_r = meteo[i];
+        remove(interval_r.begin(), interval_r.end(), ' ');
+        try
+        {
+            res.checksum += epochFromParts(stoi(interval_r.substr(0,4)), stoi(interval_r.substr(5,2)), stoi(interval_r.substr(8,2)), stoi(interval_r.substr(10,2)), stoi(interval_r.substr(13,2)), stoi(interval_r.substr(16,2)));
+        }
+        catch (...)
+        {
+        }
+        res.bytes += picarro[i].size() + meteo[i].size();
+        res.rows += 2;
+    };
+    res.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+};
+
+//digit by digit without strings, same layout checks as the decoder
+inline int digitsAt(const string &s, size_t pos, int n)
+{
+    int value = 0;
+    for (int j = 0; j < n; j++){value = value*10 + (s[pos+j]-'0');};
+    return value;
+};
+
+void scalarTime(vector<string> &picarro, vector<string> &meteo, BenchResult &res)
+{
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < picarro.size(); i++)
+    {
+        const string *fields[2] = {&picarro[i], &meteo[i]};
+        for (int f = 0; f < 2; f++)
+        {
+            const string &s = *fields[f];
+            bool digits = 1;
+            for (size_t j = 0; j < 19; j++)
+            {
+                if (j == 4 || j == 7 || j == 10 || j == 13 || j == 16){continue;};
+                if (s[j] < '0' || s[j] > '9'){digits = 0;};
+            };
+            if (!digits){continue;};
+            res.checksum += epochFromParts(digitsAt(s,0,4), digitsAt(s,5,2), digitsAt(s,8,2), digitsAt(s,11,2), digitsAt(s,14,2), digitsAt(s,17,2));
+        };
+        res.bytes += picarro[i].size() + meteo[i].size();
+        res.rows += 2;
+    };
+    res.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+};
+
+void swarTime(vector<string> &picarro, vector<string> &meteo, BenchResult &res)
+{
+    TimeStamp time_stamp;
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < picarro.size(); i++)
+    {
+        if (decodeTimestamp(picarro[i], time_stamp)){res.checksum += time_stamp.epoch;};
+        if (decodeTimestamp(meteo[i], time_stamp)){res.checksum += time_stamp.epoch;};
+        res.bytes += picarro[i].size() + meteo[i].size();
+        res.rows += 2;
+    };
+    res.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+};
+
+//compare timestamp parsing on generated timestamps
+void benchTime(long n)
+{
+    vector<string> picarro, meteo;
+    makeTimestamps(n, picarro, meteo);
+    BenchResult legacy, scalar, swar;
+    legacy.name = "substr/stoi";
+    scalar.name = "scalar digits";
+    swar.name = "SWAR decoder";
+    legacyTime(picarro, meteo, legacy);
+    printResult(legacy);
+    scalarTime(picarro, meteo, scalar);
+    printResult(scalar);
+    swarTime(picarro, meteo, swar);
+    printResult(swar);
+    cout << "Speed-up: " << legacy.seconds/swar.seconds << "x" << endl;
+};
+
+//time codes YYYYMMDDHHMMSS of one minute means and of Standards every 'every' minutes
+void makeCalibration(long years, long n_std, vector<double> &timed, Calibration &calib)
+{
+    int year, month, day, hour, min, sec;
+    long n = years*525600;
+    long every = n_std > 0 ? n/n_std : n;
+    for (long i = 0; i < n; i++)
+    {
+        civilFromEpoch(1514764800 + i*60, year, month, day, hour, min, sec); //from 2018
+        double time_code = ((((year*100. + month)*100. + day)*100. + hour)*100. + min)*100. + sec;
+        timed.push_back(time_code);
+        if (i % every != every/2){continue;};
+        calib.std_date.push_back(time_code + 10.);
+        if (calib.std_date.size() % 4 == 0){continue;}; //not every Standard is used for calibration
+        calib.std_date_corr.push_back(time_code + 10.);
+        calib.O18_corr_r.push_back(-8.6 + (i % 7)*0.01);
+        calib.H2_corr_r.push_back(-61.5 - (i % 5)*0.1);
+    };
+};
+
+//old way of eval_air_std.cc, linear scans over copies of the Standards
+double legacyCompare_dates(double date_amb, vector<double> date_comp, vector<double> corr)
+{
+    if(date_amb < date_comp[0]){return corr[0];};
+    if(date_amb >= date_comp[date_comp.size()-1]){return corr[corr.size()-1];};
+    for(int i = 0; i < date_comp.size()-1; i++)
+    {
+        if(date_amb >= date_comp[i] && date_amb < date_comp[i+1]){return corr[i];};
+    };
+    return 0.;
+};
+
+bool legacyCompare_dates_mem(double date_amb, vector<double> date_comp, double skip)
+{
+    for(int i = 0; i < date_comp.size(); i++)
+    {
+        if(date_amb >= date_comp[i] && date_amb < date_comp[i]+skip){return 1;};
+    };
+    return 0;
+};
+
+void legacyCalibration(vector<double> &timed, Calibration &calib, BenchResult &res)
+{
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < timed.size(); i++)
+    {
+        res.rows++;
+        if (legacyCompare_dates_mem(timed[i], calib.std_date, calib.skip)){res.checksum += 1.; continue;};
+        res.checksum += legacyCompare_dates(timed[i], calib.std_date_corr, calib.O18_corr_r);
+        res.checksum += legacyCompare_dates(timed[i], calib.std_date_corr, calib.H2_corr_r);
+    };
+    res.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+};
+
+void indexCalibration(vector<double> &timed, Calibration &calib, BenchResult &res)
+{
+    auto start = chrono::steady_clock::now();
+    DateIndex mem_index(calib.std_date), corr_index(calib.std_date_corr);
+    for (size_t i = 0; i < timed.size(); i++)
+    {
+        res.rows++;
+        if (compare_dates_mem(timed[i], mem_index, calib.skip)){res.checksum += 1.; continue;};
+        res.checksum += compare_dates(timed[i], corr_index, calib.O18_corr_r);
+        res.checksum += compare_dates(timed[i], corr_index, calib.H2_corr_r);
+    };
+    res.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+};
+
+//compare Standard lookup of memcorr_amb on generated minute means
+void benchCalibration(long years, long n_std)
+{
+    vector<double> timed;
+    Calibration calib;
+    makeCalibration(years, n_std, timed, calib);
+    cout << "Minute means: " << timed.size() << " | Standards: " << calib.std_date.size() << endl;
+    BenchResult legacy, index;
+    legacy.name = "linear scan by value";
+    index.name = "merge join";
+    legacyCalibration(timed, calib, legacy);
+    printResult(legacy);
+    indexCalibration(timed, calib, index);
+    printResult(index);
+    cout << "Speed-up: " << legacy.seconds/index.seconds << "x" << endl;
+};
+
+//old way of meanXminData, one sum per channel and results pushed one by one
+void legacyMean(vector<double> &H2O, vector<double> &H2, vector<double> &O18, int avetime, BenchResult &res)
+{
+    vector<double> H2O_mean, H2_mean, O18_mean;
+    auto start = chrono::steady_clock::now();
+    size_t i = 0;
+    while (i + avetime <= H2O.size())
+    {
+        double mean_H2O = 0, mean_H2 = 0, mean_O18 = 0;
+        for (int j = 0; j < avetime; j++)
+        {
+            mean_H2O = mean_H2O + H2O[i];
+            mean_H2 = mean_H2 + H2[i];
+            mean_O18 = mean_O18 + O18[i];
+            i++;
+        };
+        H2O_mean.push_back(mean_H2O / avetime);
+        H2_mean.push_back(mean_H2 / avetime);
+        O18_mean.push_back(mean_O18 / avetime);
+    };
+    res.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    res.rows = H2O.size();
+    res.bytes = 3.*H2O.size()*sizeof(double);
+    for (size_t k = 0; k < H2O_mean.size(); k++)
+    {
+        res.checksum += H2O_mean[k] + H2_mean[k] + O18_mean[k];
+        res.magnitude += fabs(H2O_mean[k]) + fabs(H2_mean[k]) + fabs(O18_mean[k]);
+    };
+};
+
+//sliding means summed fresh for every window
+void legacySliding(vector<double> &H2O, vector<double> &H2, vector<double> &O18, int avetime, BenchResult &res)
+{
+    vector<double> H2O_mean, H2_mean, O18_mean;
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i + avetime <= H2O.size(); i++)
+    {
+        double mean_H2O = 0, mean_H2 = 0, mean_O18 = 0;
+        for (int j = 0; j < avetime; j++)
+        {
+            mean_H2O = mean_H2O + H2O[i+j];
+            mean_H2 = mean_H2 + H2[i+j];
+            mean_O18 = mean_O18 + O18[i+j];
+        };
+        H2O_mean.push_back(mean_H2O / avetime);
+        H2_mean.push_back(mean_H2 / avetime);
+        O18_mean.push_back(mean_O18 / avetime);
+    };
+    res.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    res.rows = H2O.size();
+    res.bytes = 3.*H2O.size()*sizeof(double);
+    for (size_t k = 0; k < H2O_mean.size(); k++)
+    {
+        res.checksum += H2O_mean[k] + H2_mean[k] + O18_mean[k];
+        res.magnitude += fabs(H2O_mean[k]) + fabs(H2_mean[k]) + fabs(O18_mean[k]);
+    };
+};
+
+void kernelMean(vector<double> &H2O, vector<double> &H2, vector<double> &O18, int avetime, MeanMode mode, BenchResult &res)
+{
+    size_t count = meanCount(H2O.size(), avetime, mode);
+    vector<double> H2O_mean(count), H2_mean(count), O18_mean(count);
+    auto start = chrono::steady_clock::now();
+    windowMean3(H2O.data(), H2.data(), O18.data(), H2O.size(), avetime, mode, H2O_mean.data(), H2_mean.data(), O18_mean.data());
+    res.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    res.rows = H2O.size();
+    res.bytes = 3.*H2O.size()*sizeof(double);
+    for (size_t k = 0; k < count; k++)
+    {
+        res.checksum += H2O_mean[k] + H2_mean[k] + O18_mean[k];
+        res.magnitude += fabs(H2O_mean[k]) + fabs(H2_mean[k]) + fabs(O18_mean[k]);
+    };
+};
+
+//the kernel sums a window in 4 lanes, in another order than the scalar loop, so the means differ
+//in the last bits: checksums agree if they differ by less than tolerance of the summed magnitudes
+void printAgreement(BenchResult &scalar, BenchResult &kernel, double tolerance)
+{
+    double diff = fabs(scalar.checksum - kernel.checksum);
+    double scale = scalar.magnitude > 0. ? scalar.magnitude : 1.;
+    cout << scientific << setprecision(2) << "Checksum difference " << diff/scale << " of the magnitude, tolerance " << tolerance
+         << (diff <= tolerance*scale ? " (agree)" : " (DIFFERENT)") << fixed << endl;
+};
+
+//compare averaging on generated samples (a year of 1 Hz data is about 31.5 million)
+void benchMean(long n)
+{
+    vector<double> H2O(n), H2(n), O18(n);
+    for (long i = 0; i < n; i++)
+    {
+        H2O[i] = 15000. + (i % 997)*3.1;
+        H2[i] = -80. + (i % 89)*0.37;
+        O18[i] = -11. + (i % 53)*0.021;
+    };
+    BenchResult legacy, block, legacy_sliding, sliding;
+    legacy.name = "scalar blocks";
+    block.name = "kernel blocks";
+    legacy_sliding.name = "scalar sliding";
+    sliding.name = "kernel sliding";
+    legacyMean(H2O, H2, O18, 60, legacy);
+    printResult(legacy);
+    kernelMean(H2O, H2, O18, 60, mean_block, block);
+    printResult(block);
+    printAgreement(legacy, block, 1e-12);
+    cout << "Speed-up blocks: " << legacy.seconds/block.seconds << "x" << endl;
+    legacySliding(H2O, H2, O18, 60, legacy_sliding);
+    printResult(legacy_sliding);
+    kernelMean(H2O, H2, O18, 60, mean_sliding, sliding);
+    printResult(sliding);
+    printAgreement(legacy_sliding, sliding, 1e-12);
+    cout << "Speed-up sliding: " << legacy_sliding.seconds/sliding.seconds << "x" << endl;
+};
+
+//old way of drawGraphDiurnal and drawGraphSeason, "00".."23" and "01".."12" compared for every point
+void legacyGroup(vector<string> &hour, vector<string> &month_str, vector<double> &O18, BenchResult &res)
+{
+    auto start = chrono::steady_clock::now();
+    vector<vector<double>> by_hour(24), by_season(4);
+    const char *hours[24] = {"00","01","02","03","04","05","06","07","08","09","10","11","12","13","14","15","16","17","18","19","20","21","22","23"};
+    for (size_t i = 0; i < O18.size(); i++)
+    {
+        for (int h = 0; h < 24; h++){if (hour[i] == hours[h]){by_hour[h].push_back(O18[i]);};};
+        if (month_str[i] == "01" || month_str[i] == "02" || month_str[i] == "12"){by_season[0].push_back(O18[i]);};
+        if (month_str[i] == "03" || month_str[i] == "04" || month_str[i] == "05"){by_season[1].push_back(O18[i]);};
+        if (month_str[i] == "06" || month_str[i] == "07" || month_str[i] == "08"){by_season[2].push_back(O18[i]);};
+        if (month_str[i] == "09" || month_str[i] == "10" || month_str[i] == "11"){by_season[3].push_back(O18[i]);};
+    };
+    //empty groups (less than a year of rows) are left out of the checksum like in bucketGroup
+    for (int h = 0; h < 24; h++){if (!by_hour[h].empty()){res.checksum += accumulate(by_hour[h].begin(), by_hour[h].end(), 0.) / by_hour[h].size();};};
+    for (int k = 0; k < 4; k++){if (!by_season[k].empty()){res.checksum += accumulate(by_season[k].begin(), by_season[k].end(), 0.) / by_season[k].size();};};
+    res.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    res.rows = O18.size();
+    res.bytes = O18.size()*(sizeof(double) + 2*sizeof(string));
+};
+
+//one pass per channel over byte keys
+void bucketGroup(vector<uint8_t> &hour, vector<uint8_t> &season, vector<double> &O18, BenchResult &res)
+{
+    auto start = chrono::steady_clock::now();
+    vector<RollupCell> by_hour = groupBy<RollupCell>(hour, 24, O18);
+    vector<RollupCell> by_season = groupBy<RollupCell>(season, 4, O18);
+    for (int h = 0; h < 24; h++){if (by_hour[h].count > 0){res.checksum += by_hour[h].mean();};};
+    for (int k = 0; k < 4; k++){if (by_season[k].count > 0){res.checksum += by_season[k].mean();};};
+    res.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    res.rows = O18.size();
+    res.bytes = O18.size()*(sizeof(double) + 2*sizeof(uint8_t));
+};
+
+//compare grouping on generated minute means
+void benchGroup(long n)
+{
+    vector<string> hour_str(n), month_str(n);
+    vector<uint8_t> hour(n), season(n);
+    vector<double> O18(n);
+    int year, month, day, h, min, sec;
+    char two_digits[3];
+    for (long i = 0; i < n; i++)
+    {
+        civilFromEpoch(1514764800 + i*60, year, month, day, h, min, sec); //from 2018
+        snprintf(two_digits, sizeof(two_digits), "%02d", h);
+        hour_str[i] = two_digits;
+        snprintf(two_digits, sizeof(two_digits), "%02d", month);
+        month_str[i] = two_digits;
+        hour[i] = h;
+        season[i] = seasonOfMonth(month);
+        O18[i] = -11. + (i % 53)*0.021;
+    };
+    BenchResult legacy, bucket;
+    legacy.name = "string compares";
+    bucket.name = "byte keys";
+    legacyGroup(hour_str, month_str, O18, legacy);
+    printResult(legacy);
+    bucketGroup(hour, season, O18, bucket);
+    printResult(bucket);
+    cout << "Speed-up: " << legacy.seconds/bucket.seconds << "x" << endl;
+};
+
+//decimate generated minute means, a noisy seasonal cycle with a few spikes
+void benchDecimate(long n)
+{
+    vector<double> t(n), O18(n), H2(n);
+    for (long i = 0; i < n; i++)
+    {
+        t[i] = 1514764800. + i*60.;
+        O18[i] = -12. + 3.*sin(i*2.*M_PI/525600.) + 1.5*sin(i*2.*M_PI/1440.) + ((i*7919) % 1000)*0.001 + (i % 50000 == 0 ? 8. : 0.);
+        H2[i] = 8.*O18[i] + 10. + ((i*104729) % 1000)*0.004;
+    };
+    BenchResult lttb, density;
+    vector<double> out_x, out_y;
+    lttb.name = "LTTB 4000";
+    auto start = chrono::steady_clock::now();
+    decimateLTTB(t.data(), O18.data(), n, 4000, out_x, out_y);
+    lttb.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    lttb.rows = n;
+    lttb.bytes = 2.*n*sizeof(double);
+    for (size_t k = 0; k < out_y.size(); k++){lttb.checksum += out_y[k];};
+    printResult(lttb);
+    cout << "Points left: " << out_x.size() << " of " << n << ", largest kept " << *max_element(out_y.begin(), out_y.end()) << " of " << *max_element(O18.begin(), O18.end()) << endl;
+
+    density.name = "density 1000x375";
+    start = chrono::steady_clock::now();
+    decimateDensity(O18.data(), H2.data(), n, 1000, 375, out_x, out_y);
+    density.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    density.rows = n;
+    density.bytes = 2.*n*sizeof(double);
+    for (size_t k = 0; k < out_y.size(); k++){density.checksum += out_y[k];};
+    printResult(density);
+    cout << "Points left: " << out_x.size() << " of " << n << endl;
+};
+
+//write a synthetic data set
+void benchGenerate(string folder, int days, string first_day, int interval)
+{
+    SynthSettings settings;
+    settings.days = days;
+    settings.interval = interval;
+    if (first_day.size() == 8){settings.start = epochFromParts(stoi(first_day.substr(0,4)), stoi(first_day.substr(4,2)), stoi(first_day.substr(6,2)), 0, 0, 0);};
+    SynthGenerator generator(settings);
+    BenchResult res;
+    res.name = "generate";
+    auto start = chrono::steady_clock::now();
+    bool ok = generator.writeAll(folder);
+    res.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    res.rows = generator.rows;
+    res.bytes = generator.bytes;
+    printResult(res);
+    cout << generator.files << " files in " << folder << ", years:";
+    for (int year : generator.years()){cout << " " << year;};
+    cout << endl;
+    if (!ok){cout << "Could not write all files to " << folder << endl;};
+};
+
+//prints the stages of a report csv written by stage_report.h
+void printReport(string path)
+{
+    ifstream inFile(path);
+    if (!inFile.is_open()){cout << "  no report at " << path << endl; return;};
+    string line, program, started, stage, metric, value, last_stage;
+    double seconds = 0.;
+    getline(inFile, line);
+    while (getline(inFile, line))
+    {
+        stringstream stst(line);
+        getline(stst, program, ',');
+        getline(stst, started, ',');
+        getline(stst, stage, ',');
+        getline(stst, metric, ',');
+        getline(stst, value, ',');
+        if (stage != last_stage)
+        {
+            if (last_stage != ""){cout << endl;};
+            cout << "  " << setw(20) << left << stage << right;
+            last_stage = stage;
+        };
+        if (metric == "seconds"){seconds = stod(value); cout << fixed << setprecision(3) << setw(9) << seconds << " s";}
+        else if (metric == "calls"){continue;}
+        else
+        {
+            cout << " | " << metric << " " << stol(value);
+            if (metric == "rows read" && seconds > 0.){cout << " (" << setprecision(0) << stol(value)/seconds << " rows/s)";};
+        };
+    };
+    cout << endl;
+};
+
+//runs one program in batch mode and prints its report
+bool runProgram(string bindir, string binary, string args, string report)
+{
+    string command = "\"" + bindir + "/" + binary + "\" --batch --report \"" + report + "\" " + args + " > \"" + report + ".log\" 2>&1";
+    cout << "######## " << binary << endl;
+    auto start = chrono::steady_clock::now();
+    int status = system(command.c_str());
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    if (status != 0)
+    {
+        cout << "  failed with status " << status << ", see " << report << ".log" << endl;
+        return 0;
+    };
+    printReport(report + ".csv");
+    cout << fixed << setprecision(3) << "  wall time with start and exit: " << seconds << " s" << endl;
+    return 1;
+};
+
+//all programs on a data set of generate, every input is parsed again (--rebuild)
+void benchPipeline(string folder, string year, string bindir)
+{
+    string eval = folder + "/eval";
+    string reports = folder + "/reports";
+    error_code ec;
+    filesystem::create_directories(eval + "/End", ec);
+    filesystem::create_directories(reports, ec);
+    string q = "\"";
+
+    runProgram(bindir, "Ambient.o", "--rebuild --year " + year + " --input " + q + folder + "/csv" + q + " --output " + q + eval + q, reports + "/ambient");
+    runProgram(bindir, "Standards_eval_corr.o", "--rebuild --year " + year + " --input " + q + folder + "/csv" + q + " --output " + q + eval + q + " --ids " + q + folder + "/ids.txt" + q, reports + "/standards_eval_corr");
+    runProgram(bindir, "Eval_air_std.o", "--year " + year + " --ambient " + q + eval + "/Ambient_data_" + year + ".pcol" + q + " --standards " + q + eval + "/Standards_eval_end_data_corr" + year + ".txt" + q + " --output " + q + eval + q, reports + "/eval_air_std");
+    string meteo = folder + "/meteo/Meteo_" + year + "_10min.dat";
+    runProgram(bindir, "Ambient_eval_meteo.o", "--rebuild --year " + year + " --ambient " + q + eval + "/End/Ambient_data_" + year + "_corr.pcol" + q + " --meteo " + q + meteo + q + " --output " + q + eval + q, reports + "/ambient_eval_meteo");
+
+    //rainwater_eval takes the years from the samples and the meteo files of every year there is
+    vector<string> meteo_files;
+    for (auto &entry : filesystem::directory_iterator(folder + "/meteo", ec))
+    {
+        if (entry.path().extension() == ".dat"){meteo_files.push_back(entry.path().string());};
+    };
+    sort(meteo_files.begin(), meteo_files.end());
+    string list;
+    for (size_t i = 0; i < meteo_files.size(); i++){list += (i ? "," : "") + meteo_files[i];};
+    runProgram(bindir, "Rainwater_eval.o", "--event " + q + folder + "/rain/event.csv" + q + " --month " + q + folder + "/rain/month.csv" + q + " --flask " + q + folder + "/rain/flask.csv" + q + " --meteo " + q + list + q + " --output " + q + eval + q, reports + "/rainwater_eval");
+};
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        cout << "usage: " << argv[0] << " reader FILE.csv [FILE.csv ...]" << endl;
+        cout << "       " << argv[0] << " time [N]" << endl;
+        cout << "       " << argv[0] << " calib [YEARS] [STANDARDS]" << endl;
+        cout << "       " << argv[0] << " mean [N]" << endl;
+        cout << "       " << argv[0] << " group [N]" << endl;
+        cout << "       " << argv[0] << " decimate [N]" << endl;
+        cout << "       " << argv[0] << " generate DIR [DAYS] [YYYYMMDD] [INTERVAL]" << endl;
+        cout << "       " << argv[0] << " pipeline DIR YEAR [BINDIR]" << endl;
+        return 1;
+    };
+    string mode = argv[1];
+    vector<string> files;
+    for (int i = 2; i < argc; i++){files.push_back(argv[i]);};
+
+    if (mode == "reader" && !files.empty()){benchReader(files);}
+    else if (mode == "time"){benchTime(files.empty() ? 5000000 : stol(files[0]));}
+    else if (mode == "mean"){benchMean(files.empty() ? 31536000 : stol(files[0]));}
+    else if (mode == "group"){benchGroup(files.empty() ? 525600 : stol(files[0]));}
+    else if (mode == "decimate"){benchDecimate(files.empty() ? 525600 : stol(files[0]));}
+    else if (mode == "generate" && !files.empty()){benchGenerate(files[0], files.size() > 1 ? stoi(files[1]) : 7, files.size() > 2 ? files[2] : "20210101", files.size() > 3 ? stoi(files[3]) : 1);}
+    else if (mode == "pipeline" && files.size() > 1){benchPipeline(files[0], files[1], files.size() > 2 ? files[2] : ".");}
+    else if (mode == "calib"){benchCalibration(files.size() > 0 ? stol(files[0]) : 3, files.size() > 1 ? stol(files[1]) : 2000);}
+    else
+    {
+        cout << "Unknown benchmark " << mode << endl;
+        return 1;
+    };
+
+    return 0;
+}
@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////////
+// Grouping of samples by small integer keys for the Picarro L-2130i tools//
+// author: Sebastian Stezura // E-Mail: sebastian_stezura@gmx.net         //
+// GitHub: CplusplusB                                                     //
+// version: 1 // date: 17.10.2026                                         //
+////////////////////////////////////////////////////////////////////////////
+
+//hour of day, month and season are stored as one byte per sample when the data is read,
+//grouping by them is a counting sort of the keys (BucketIndex) or one pass of an accumulator
+//over a channel (groupBy), no strings are compared and nothing is allocated per sample
+//groupBy can split the samples into parts summed by their own threads, the parts are merged in order
+//keys outside [0, buckets) are not in any bucket
+
+#ifndef BUCKET_INDEX_H
+#define BUCKET_INDEX_H
+
+#include <vector> //for using vectors
+#include <cstdint> //fixed size types
+#include <cstddef> //for size_t
+#include <thread> //multithreading
+#include <functional> //for ref
+
+//seasons 0=Winter (Dec-Feb), 1=Spring (Mar-May), 2=Summer (Jun-Aug), 3=Autumn (Sep-Nov)
+inline uint8_t seasonOfMonth(int month){return static_cast<uint8_t>(month % 12 / 3);};
+
+//rows of every bucket in the order of the samples
+class BucketIndex
+{
+public:
+    BucketIndex(const std::vector<uint8_t> &key, size_t buckets)
+    {
+        offset_.assign(buckets + 1, 0);
+        for (size_t i = 0; i < key.size(); i++)
+        {
+            if (key[i] < buckets){offset_[key[i] + 1]++;};
+        };
+        for (size_t b = 0; b < buckets; b++){offset_[b + 1] += offset_[b];};
+        row_.resize(offset_[buckets]);
+        std::vector<size_t> next(offset_.begin(), offset_.end() - 1);
+        for (size_t i = 0; i < key.size(); i++)
+        {
+            if (key[i] < buckets){row_[next[key[i]]++] = i;};
+        };
+    };
+
+    size_t buckets() const {return offset_.size() - 1;};
+    size_t size(size_t bucket) const {return offset_[bucket + 1] - offset_[bucket];};
+    const size_t *begin(size_t bucket) const {return row_.data() + offset_[bucket];};
+    const size_t *end(size_t bucket) const {return row_.data() + offset_[bucket + 1];};
+
+    //values of channel in bucket, out is reused
+    void gather(size_t bucket, const std::vector<double> &channel, std::vector<double> &out) const
+    {
+        out.resize(size(bucket));
+        const size_t *row = begin(bucket);
+        for (size_t k = 0; k < out.size(); k++){out[k] = channel[row[k]];};
+    };
+
+private:
+    std::vector<size_t> offset_; //first row of every bucket in row_
+    std::vector<size_t> row_;
+};
+
+//accumulators of the samples [begin, end)
+template <class Cell>
+void groupRange(const std::vector<uint8_t> &key, const std::vector<double> &channel, size_t begin, size_t end, std::vector<Cell> &cells)
+{
+    for (size_t i = begin; i < end; i++)
+    {
+        double x = channel[i];
+        if (key[i] < cells.size() && x == x){cells[key[i]].add(x);};
+    };
+};
+
+//one accumulator per bucket over a channel in a single pass, missing values (NaN) are not added
+//Cell needs add(double) and merge(const Cell&), e.g. RunningStats or RollupCell
+//threads > 1 sums that many parts at the same time, small inputs are summed in one
+template <class Cell>
+std::vector<Cell> groupBy(const std::vector<uint8_t> &key, size_t buckets, const std::vector<double> &channel, size_t threads = 1)
+{
+    size_t n = key.size() < channel.size() ? key.size() : channel.size();
+    if (threads == 0 || n < threads * 65536){threads = 1;};
+    std::vector<std::vector<Cell>> part(threads, std::vector<Cell>(buckets));
+    if (threads == 1){groupRange(key, channel, 0, n, part[0]); return part[0];};
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; t++)
+    {
+        workers.emplace_back(groupRange<Cell>, std::cref(key), std::cref(channel), n * t / threads, n * (t + 1) / threads, std::ref(part[t]));
+    };
+    for (std::thread &worker : workers){worker.join();};
+    for (size_t t = 1; t < threads; t++)
+    {
+        for (size_t b = 0; b < buckets; b++){part[0][b].merge(part[t][b]);};
+    };
+    return part[0];
+};
+
+#endif
@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////
+// Standard lookup for the calibration of ambient air (Picarro L-2130i)   //
+// author: Sebastian Stezura // E-Mail: sebastian_stezura@gmx.net         //
+// GitHub: CplusplusB                                                     //
+// version: 1 // date: 17.10.2026                                         //
+////////////////////////////////////////////////////////////////////////////
+
+//every averaged ambient point needs the Standard measured before it (calibration)
+//and has to be checked against the end of all Standards (memory skip)
+//the Standard dates are sorted once, the ambient points come in time order,
+//so a cursor only moves forward over the dates (merge join) and the whole year
+//is matched in O(N+M), points out of order are found by binary search
+
+#ifndef CALIBRATION_H
+#define CALIBRATION_H
+
+#include <vector> //for using vectors
+#include <algorithm> //for sorting and binary search
+#include <numeric> //for iota
+
+//sorted dates with a cursor at the last lookup
+class DateIndex
+{
+public:
+    DateIndex(const std::vector<double> &dates) : dates_(dates){};
+
+    //number of dates <= t
+    size_t upper(double t)
+    {
+        if (pos_ > 0 && t < dates_[pos_-1])
+        {
+            pos_ = std::upper_bound(dates_.begin(), dates_.end(), t) - dates_.begin();
+            return pos_;
+        };
+        while (pos_ < dates_.size() && dates_[pos_] <= t){pos_++;};
+        return pos_;
+    };
+    const std::vector<double> &dates() const {return dates_;};
+
+private:
+    const std::vector<double> &dates_;
+    size_t pos_ = 0;
+};
+
+//Standards for Memory Correction and Calibration of Ambient Air
+class Calibration
+{
+public:
+    std::vector<double> std_date; //all Standards, memory after them is skipped
+    std::vector<double> std_date_corr, O18_corr_r, H2_corr_r; //averaged Standards
+    double skip = 300.;
+    double O18_true = -8.65; //O18 Value of Standard
+    double H2_true = -61.55; //H2 value of Standard
+
+    //Standards are in time order in the file, sorting only guards the lookup
+    void sort()
+    {
+        std::stable_sort(std_date.begin(), std_date.end());
+        std::vector<size_t> order(std_date_corr.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b){return std_date_corr[a] < std_date_corr[b];});
+        std::vector<double> date, O18, H2;
+        for (size_t i = 0; i < order.size(); i++)
+        {
+            date.push_back(std_date_corr[order[i]]);
+            O18.push_back(O18_corr_r[order[i]]);
+            H2.push_back(H2_corr_r[order[i]]);
+        };
+        std_date_corr.swap(date);
+        O18_corr_r.swap(O18);
+        H2_corr_r.swap(H2);
+    };
+};
+
+//Compare times for Correction
+//value of the last Standard before date_amb, first one before all Standards
+inline double compare_dates(double date_amb, DateIndex &date_comp, const std::vector<double> &corr)
+{
+    if (corr.empty()){return 0.;};
+    size_t n = date_comp.upper(date_amb);
+    if (n == 0){return corr.front();};
+    return corr[n-1];
+};
+
+//Compare times for Memory
+//true if date_amb is less than skip after the end of a Standard
+inline bool compare_dates_mem(double date_amb, DateIndex &date_comp, double skip)
+{
+    size_t n = date_comp.upper(date_amb);
+    return n > 0 && date_amb < date_comp.dates()[n-1] + skip;
+};
+
+#endif
@@ -0,0 +1,471 @@
+////////////////////////////////////////////////////////////////////////////
+// Column store for intermediate files of the Picarro L-2130i tools       //
+// author: Sebastian Stezura // E-Mail: sebastian_stezura@gmx.net         //
+// GitHub: CplusplusB                                                     //
+// version: 1 // date: 17.10.2026                                         //
+////////////////////////////////////////////////////////////////////////////
+
+//binary replacement of the text files between the programs (Ambient_data_YEAR.txt ...)
+//layout, all numbers little endian:
+//  StoreHeader                     fixed 64 bytes, magic "PICCOL" and format version
+//  StoreColumn[n_columns]          name, type and position of every column
+//  meta text                       free text header of the text file (evaluation time, files, ...)
+//  column data                     n_rows values per column, contiguous, 8 byte aligned
+//  dictionary                      for dict columns: uint32 length + characters per entry
+//the reader maps the file and hands out pointers directly into the mapping
+
+#ifndef COLUMN_STORE_H
+#define COLUMN_STORE_H
+
+//shared reader for mapping files
+#include "picarro_reader.h"
+//typed columns and number format
+#include "data_columns.h"
+
+#include <string> //for using strings
+#include <string_view> //for views into the mapping
+#include <vector> //for using vectors
+#include <fstream> //for writing files
+#include <iomanip> //for text export format
+#include <cstdint> //fixed size types
+#include <cstring> //for memcpy
+#include <cstdio> //for removing temporary files
+#include <filesystem> //for renaming finished files
+
+const char store_magic[8] = {'P','I','C','C','O','L','\0','\0'};
+const uint32_t store_version = 1;
+const std::string store_extension = ".pcol";
+
+enum StoreType : uint32_t
+{
+    store_float64 = 1,
+    store_int64 = 2,
+    store_int32 = 3,
+    store_dict = 4 //int32 codes into a dictionary of strings
+};
+
+struct StoreHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t n_columns;
+    uint64_t n_rows;
+    uint64_t meta_offset;
+    uint64_t meta_bytes;
+    char type[24]; //what is stored, e.g. "Ambient"
+};
+
+struct StoreColumn
+{
+    char name[24];
+    uint32_t type;
+    int32_t precision; //fixed digits for the text export, -1 for shortest exact number
+    uint64_t offset; //data from begin of file
+    uint64_t dict_offset;
+    uint64_t dict_size; //number of dictionary entries
+};
+
+static_assert(sizeof(StoreHeader) == 64, "store header must stay 64 bytes");
+static_assert(sizeof(StoreColumn) == 56, "store column entry must stay 56 bytes");
+
+//check if a file is a column store by its first bytes
+inline bool isColumnStore(const std::string &path)
+{
+    std::ifstream inFile(path, std::ios::binary);
+    char magic[8] = {0};
+    inFile.read(magic, 8);
+    return inFile.gcount() == 8 && memcmp(magic, store_magic, 8) == 0;
+};
+
+//collects columns and writes them as one store file
+//columns are only referenced, they have to live until write() is done
+class StoreWriter
+{
+public:
+    std::string type;
+    std::string meta;
+
+    StoreWriter(std::string store_type){type = store_type;};
+
+    void addDouble(std::string name, const std::vector<double> &values, int precision = -1)
+    {
+        add(name, store_float64, values.data(), values.size(), precision);
+    };
+    void addInt64(std::string name, const std::vector<int64_t> &values)
+    {
+        add(name, store_int64, values.data(), values.size(), 0);
+    };
+    void addInt32(std::string name, const std::vector<int32_t> &values)
+    {
+        add(name, store_int32, values.data(), values.size(), 0);
+    };
+    //codes index into dict
+    void addDict(std::string name, const std::vector<int32_t> &codes, const std::vector<std::string> &dict)
+    {
+        add(name, store_dict, codes.data(), codes.size(), 0);
+        columns_.back().dict = &dict;
+    };
+    void addDict(std::string name, const DictColumn &column)
+    {
+        addDict(name, column.codes, column.dict.names);
+    };
+
+    //float64 column read from a file of rows with row_width doubles each, value row_index of every row
+    //the file is read in blocks while writing, the column is never held in memory
+    void addRowFile(std::string name, const std::string &row_file, uint32_t row_width, uint32_t row_index, uint64_t n_rows, int precision = -1)
+    {
+        add(name, store_float64, nullptr, n_rows, precision);
+        columns_.back().row_file = row_file;
+        columns_.back().row_width = row_width;
+        columns_.back().row_index = row_index;
+    };
+    //dict column from a file of rows, the values of the rows are the codes into dict
+    void addRowFileDict(std::string name, const std::string &row_file, uint32_t row_width, uint32_t row_index, uint64_t n_rows, const std::vector<std::string> &dict)
+    {
+        addRowFile(name, row_file, row_width, row_index, n_rows, 0);
+        columns_.back().type = store_dict;
+        columns_.back().dict = &dict;
+    };
+
+    //written to path.tmp and renamed, a store that is reused (ingest segments) is never left half written
+    bool write(const std::string &path)
+    {
+        std::string tmp = path + ".tmp";
+        if (!writeFile(tmp)){std::remove(tmp.c_str()); return 0;};
+        std::error_code ec;
+        std::filesystem::rename(tmp, path, ec);
+        if (ec){std::remove(tmp.c_str()); return 0;};
+        return 1;
+    };
+
+private:
+    bool writeFile(const std::string &path)
+    {
+        uint64_t n_rows = columns_.empty() ? 0 : columns_[0].n;
+        for (size_t i = 0; i < columns_.size(); i++)
+        {
+            if (columns_[i].n != n_rows){return 0;};
+        };
+
+        StoreHeader header{};
+        memcpy(header.magic, store_magic, 8);
+        header.version = store_version;
+        header.n_columns = columns_.size();
+        header.n_rows = n_rows;
+        strncpy(header.type, type.c_str(), sizeof(header.type)-1);
+
+        //positions of all blocks
+        uint64_t pos = sizeof(StoreHeader) + columns_.size()*sizeof(StoreColumn);
+        header.meta_offset = pos;
+        header.meta_bytes = meta.size();
+        pos = align(pos + meta.size());
+        std::vector<StoreColumn> entries(columns_.size());
+        for (size_t i = 0; i < columns_.size(); i++)
+        {
+            StoreColumn &entry = entries[i];
+            entry = StoreColumn{};
+            strncpy(entry.name, columns_[i].name.c_str(), sizeof(entry.name)-1);
+            entry.type = columns_[i].type;
+            entry.precision = columns_[i].precision;
+            entry.offset = pos;
+            pos = align(pos + n_rows*typeSize(columns_[i].type));
+            if (columns_[i].dict)
+            {
+                entry.dict_offset = pos;
+                entry.dict_size = columns_[i].dict->size();
+                for (size_t j = 0; j < columns_[i].dict->size(); j++){pos += sizeof(uint32_t) + (*columns_[i].dict)[j].size();};
+                pos = align(pos);
+            };
+        };
+
+        std::ofstream outFile(path, std::ios::binary | std::ios::trunc);
+        if (!outFile.is_open()){return 0;};
+        outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        outFile.write(reinterpret_cast<const char*>(entries.data()), entries.size()*sizeof(StoreColumn));
+        outFile.write(meta.data(), meta.size());
+        uint64_t written = header.meta_offset + meta.size();
+        for (size_t i = 0; i < columns_.size(); i++)
+        {
+            pad(outFile, written, entries[i].offset);
+            if (!columns_[i].row_file.empty())
+            {
+                if (!copyRowFile(outFile, columns_[i])){return 0;};
+            }
+            else {outFile.write(static_cast<const char*>(columns_[i].data), n_rows*typeSize(columns_[i].type));};
+            written += n_rows*typeSize(columns_[i].type);
+            if (columns_[i].dict)
+            {
+                pad(outFile, written, entries[i].dict_offset);
+                for (size_t j = 0; j < columns_[i].dict->size(); j++)
+                {
+                    const std::string &entry = (*columns_[i].dict)[j];
+                    uint32_t len = entry.size();
+                    outFile.write(reinterpret_cast<const char*>(&len), sizeof(len));
+                    outFile.write(entry.data(), len);
+                    written += sizeof(len) + len;
+                };
+            };
+        };
+        pad(outFile, written, align(written));
+        return outFile.good();
+    };
+
+    struct Column
+    {
+        std::string name;
+        uint32_t type;
+        const void *data;
+        uint64_t n;
+        int precision;
+        const std::vector<std::string> *dict = nullptr;
+        std::string row_file;
+        uint32_t row_width = 0, row_index = 0;
+    };
+    std::vector<Column> columns_;
+
+    static bool copyRowFile(std::ofstream &outFile, const Column &column)
+    {
+        std::ifstream inFile(column.row_file, std::ios::binary);
+        if (!inFile.is_open()){return 0;};
+        const uint64_t block = 4096; //rows per read
+        std::vector<double> rows(block*column.row_width), values(block);
+        std::vector<int32_t> codes(block);
+        for (uint64_t done = 0; done < column.n; done += block)
+        {
+            uint64_t n = column.n - done < block ? column.n - done : block;
+            inFile.read(reinterpret_cast<char*>(rows.data()), n*column.row_width*sizeof(double));
+            if (static_cast<uint64_t>(inFile.gcount()) != n*column.row_width*sizeof(double)){return 0;};
+            if (column.type == store_dict)
+            {
+                for (uint64_t j = 0; j < n; j++){codes[j] = static_cast<int32_t>(rows[j*column.row_width + column.row_index]);};
+                outFile.write(reinterpret_cast<const char*>(codes.data()), n*sizeof(int32_t));
+                continue;
+            };
+            for (uint64_t j = 0; j < n; j++){values[j] = rows[j*column.row_width + column.row_index];};
+            outFile.write(reinterpret_cast<const char*>(values.data()), n*sizeof(double));
+        };
+        return 1;
+    };
+
+    void add(std::string name, uint32_t type, const void *data, uint64_t n, int precision)
+    {
+        columns_.push_back(Column{name, type, data, n, precision});
+    };
+    static uint64_t align(uint64_t pos){return (pos + 7) & ~uint64_t(7);};
+    static void pad(std::ofstream &outFile, uint64_t &written, uint64_t target)
+    {
+        while (written < target){outFile.put('\0'); written++;};
+    };
+
+public:
+    static uint64_t typeSize(uint32_t type)
+    {
+        if (type == store_float64 || type == store_int64){return 8;};
+        return 4;
+    };
+};
+
+//writes a store of float64 columns row by row for streaming evaluations
+//rows go to a temporary file next to the store, close() builds the store from it
+//a column set with setDict() holds codes into its dictionary and is written as dict column
+class StoreRowWriter
+{
+public:
+    std::string meta;
+
+    StoreRowWriter(std::string store_type, std::string store_path, std::vector<std::string> names, std::vector<int> precisions)
+    {
+        type_ = store_type;
+        path_ = store_path;
+        names_ = names;
+        precisions_ = precisions;
+        precisions_.resize(names_.size(), -1);
+        outFile_.open(path_ + ".rows", std::ios::binary | std::ios::trunc);
+    };
+    ~StoreRowWriter(){if (outFile_.is_open()){outFile_.close(); std::remove((path_ + ".rows").c_str());};};
+
+    bool isOpen() const {return outFile_.is_open();};
+    uint64_t rows() const {return n_rows_;};
+
+    //dictionary of column, can be set any time before close()
+    void setDict(size_t column, const std::vector<std::string> &dict)
+    {
+        dicts_.resize(names_.size());
+        has_dict_.resize(names_.size());
+        dicts_[column] = dict;
+        has_dict_[column] = 1;
+    };
+
+    //one value per column
+    void push(const double *row)
+    {
+        outFile_.write(reinterpret_cast<const char*>(row), names_.size()*sizeof(double));
+        n_rows_++;
+    };
+
+    bool close()
+    {
+        if (!outFile_.is_open()){return 0;};
+        outFile_.close();
+        StoreWriter store(type_);
+        store.meta = meta;
+        for (size_t i = 0; i < names_.size(); i++)
+        {
+            if (i < has_dict_.size() && has_dict_[i]){store.addRowFileDict(names_[i], path_ + ".rows", names_.size(), i, n_rows_, dicts_[i]);}
+            else {store.addRowFile(names_[i], path_ + ".rows", names_.size(), i, n_rows_, precisions_[i]);};
+        };
+        bool written = store.write(path_);
+        std::remove((path_ + ".rows").c_str());
+        return written;
+    };
+
+private:
+    std::string type_, path_;
+    std::vector<std::string> names_;
+    std::vector<int> precisions_;
+    std::vector<std::vector<std::string>> dicts_;
+    std::vector<char> has_dict_;
+    std::ofstream outFile_;
+    uint64_t n_rows_ = 0;
+};
+
+//maps a store file, columns are pointers into the mapping
+class StoreReader
+{
+public:
+    StoreReader(){};
+    StoreReader(const std::string &path){open(path);};
+
+    bool open(const std::string &path)
+    {
+        columns_.clear();
+        dicts_.clear();
+        if (!file_.open(path) || file_.size() < sizeof(StoreHeader)){return fail();};
+        base_ = file_.view().data();
+        memcpy(&header_, base_, sizeof(header_));
+        if (memcmp(header_.magic, store_magic, 8) != 0 || header_.version != store_version){return fail();};
+        if (sizeof(StoreHeader) + header_.n_columns*sizeof(StoreColumn) > file_.size()){return fail();};
+        columns_.resize(header_.n_columns);
+        memcpy(columns_.data(), base_ + sizeof(StoreHeader), header_.n_columns*sizeof(StoreColumn));
+        dicts_.resize(header_.n_columns);
+        //every range is checked against the file, a truncated or broken store is not read
+        const uint64_t size = file_.size();
+        if (header_.meta_offset > size || header_.meta_bytes > size - header_.meta_offset){return fail();};
+        for (size_t i = 0; i < columns_.size(); i++)
+        {
+            if (memchr(columns_[i].name, '\0', sizeof(columns_[i].name)) == nullptr){return fail();};
+            if (columns_[i].offset > size || header_.n_rows > (size - columns_[i].offset)/StoreWriter::typeSize(columns_[i].type)){return fail();};
+            if (columns_[i].type != store_dict){continue;};
+            if (columns_[i].dict_offset > size){return fail();};
+            const char *p = base_ + columns_[i].dict_offset;
+            const char *end = base_ + size;
+            for (uint64_t j = 0; j < columns_[i].dict_size; j++)
+            {
+                uint32_t len;
+                if (static_cast<uint64_t>(end - p) < sizeof(len)){return fail();};
+                memcpy(&len, p, sizeof(len));
+                if (static_cast<uint64_t>(end - p) - sizeof(len) < len){return fail();};
+                dicts_[i].push_back(std::string_view(p + sizeof(len), len));
+                p += sizeof(len) + len;
+            };
+        };
+        return 1;
+    };
+
+    bool isOpen() const {return file_.isOpen();};
+    uint64_t rows() const {return header_.n_rows;};
+    std::string type() const {return std::string(header_.type);};
+    std::string_view meta() const {return std::string_view(base_ + header_.meta_offset, header_.meta_bytes);};
+    size_t columns() const {return columns_.size();};
+    std::string columnName(size_t i) const {return std::string(columns_[i].name);};
+
+    //index of column or -1 if missing
+    int find(const std::string &name) const
+    {
+        for (size_t i = 0; i < columns_.size(); i++)
+        {
+            if (name == columns_[i].name){return i;};
+        };
+        return -1;
+    };
+
+    const double *getDouble(const std::string &name) const {return get<double>(name, store_float64);};
+    const int64_t *getInt64(const std::string &name) const {return get<int64_t>(name, store_int64);};
+    const int32_t *getInt32(const std::string &name) const {return get<int32_t>(name, store_int32);};
+    //codes of a dict column, entries via dictionary()
+    const int32_t *getCodes(const std::string &name) const {return get<int32_t>(name, store_dict);};
+    const std::vector<std::string_view> &dictionary(const std::string &name) const
+    {
+        static const std::vector<std::string_view> empty;
+        int i = find(name);
+        return i < 0 ? empty : dicts_[i];
+    };
+
+    //write the store like the old text files: meta text, header line, one row per line
+    bool exportText(const std::string &path) const
+    {
+        std::ofstream outFile(path);
+        if (!outFile.is_open()){return 0;};
+        outFile << meta();
+        for (size_t i = 0; i < columns_.size(); i++)
+        {
+            outFile << (i == 0 ? "" : ",") << columns_[i].name;
+        };
+        outFile << std::endl;
+        for (uint64_t j = 0; j < header_.n_rows; j++)
+        {
+            for (size_t i = 0; i < columns_.size(); i++)
+            {
+                if (i != 0){outFile << ",";};
+                const char *p = base_ + columns_[i].offset;
+                if (columns_[i].type == store_float64)
+                {
+                    double value;
+                    memcpy(&value, p + j*sizeof(double), sizeof(double));
+                    if (columns_[i].precision < 0){outFile << formatNumber(value);}
+                    else {outFile << std::fixed << std::setprecision(columns_[i].precision) << value;};
+                }
+                else if (columns_[i].type == store_int64)
+                {
+                    int64_t value;
+                    memcpy(&value, p + j*sizeof(int64_t), sizeof(int64_t));
+                    outFile << value;
+                }
+                else
+                {
+                    int32_t value;
+                    memcpy(&value, p + j*sizeof(int32_t), sizeof(int32_t));
+                    if (columns_[i].type == store_dict && value >= 0 && value < (int32_t)dicts_[i].size()){outFile << dicts_[i][value];}
+                    else {outFile << value;};
+                };
+            };
+            outFile << "\n";
+        };
+        return outFile.good();
+    };
+
+private:
+    //a store that can not be read leaves the reader closed and empty
+    bool fail()
+    {
+        file_.close();
+        columns_.clear();
+        dicts_.clear();
+        return 0;
+    };
+
+    template <class T> const T *get(const std::string &name, uint32_t type) const
+    {
+        int i = find(name);
+        if (i < 0 || columns_[i].type != type){return nullptr;};
+        return reinterpret_cast<const T*>(base_ + columns_[i].offset);
+    };
+
+    MappedFile file_;
+    const char *base_ = nullptr;
+    StoreHeader header_{};
+    std::vector<StoreColumn> columns_;
+    std::vector<std::vector<std::string_view>> dicts_;
+};
+
+#endif
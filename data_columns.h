@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////////////////////
+// Typed columns for the data classes of the Picarro L-2130i tools        //
+// author: Sebastian Stezura // E-Mail: sebastian_stezura@gmx.net         //
+// GitHub: CplusplusB                                                     //
+// version: 1 // date: 17.10.2026                                         //
+////////////////////////////////////////////////////////////////////////////
+
+//values are parsed once when reading and kept as numbers:
+//  vector<double>   measured values and the time code YYYYMMDDHHMMSS.sss
+//  vector<int32_t>  counters like injection number, missing values are missing_int
+//  vector<int64_t>  epoch seconds (UTC) of the time code
+//  DictColumn       repeating strings (identifier, analysis, port) as int32 codes
+
+#ifndef DATA_COLUMNS_H
+#define DATA_COLUMNS_H
+
+//shared reader for number parsing
+#include "picarro_reader.h"
+//date to epoch seconds
+#include "picarro_time.h"
+
+#include <string> //for using strings
+#include <string_view> //for views into the mapping
+#include <vector> //for using vectors
+#include <functional> //for hashing dictionary values
+#include <limits> //for NaN
+#include <cmath> //for number format
+#include <cstdio> //for snprintf
+#include <cstdlib> //for strtod
+#include <cstdint> //fixed size types
+
+const int32_t missing_int = std::numeric_limits<int32_t>::min();
+
+//unique strings with their index
+class Dictionary
+{
+public:
+    std::vector<std::string> names;
+
+    //index of value or -1, no state is changed so threads can look up at the same time
+    int32_t find(std::string_view value) const
+    {
+        if (slots_.empty()){return -1;};
+        for (size_t i = slot(value);; i = (i + 1) & (slots_.size() - 1))
+        {
+            if (slots_[i] < 0){return -1;};
+            if (names[slots_[i]] == value){return slots_[i];};
+        };
+    };
+    //index of value, added if it is new
+    int32_t add(std::string_view value)
+    {
+        int32_t code = find(value);
+        if (code >= 0){return code;};
+        code = names.size();
+        names.emplace_back(value);
+        if (2*names.size() > slots_.size()){rehash(slots_.empty() ? 16 : 2*slots_.size());}
+        else {insert(code);};
+        return code;
+    };
+    bool contains(std::string_view value) const {return find(value) >= 0;};
+    size_t size() const {return names.size();};
+    const std::string &operator[](size_t code) const {return names[code];};
+    void clear(){names.clear(); slots_.clear();};
+
+private:
+    //open addressing over the codes, the strings are only kept in names
+    //so values are looked up as string_view without building a string
+    std::vector<int32_t> slots_; //code or -1, size is a power of two
+
+    size_t slot(std::string_view value) const {return std::hash<std::string_view>()(value) & (slots_.size() - 1);};
+    void insert(int32_t code)
+    {
+        size_t i = slot(names[code]);
+        while (slots_[i] >= 0){i = (i + 1) & (slots_.size() - 1);};
+        slots_[i] = code;
+    };
+    void rehash(size_t n_slots)
+    {
+        slots_.assign(n_slots, -1);
+        for (size_t code = 0; code < names.size(); code++){insert(code);};
+    };
+};
+
+//column of repeating strings, every row holds the code of its string
+class DictColumn
+{
+public:
+    std::vector<int32_t> codes;
+    Dictionary dict;
+
+    void push_back(std::string_view value){codes.push_back(dict.add(value));};
+    void reserve(size_t n){codes.reserve(n);};
+    size_t size() const {return codes.size();};
+    bool empty() const {return codes.empty();};
+    const std::string &operator[](size_t i) const {return dict[codes[i]];};
+    void clear(){codes.clear(); dict.clear();};
+};
+
+//number of a field or NaN if it is empty
+inline double parseValue(std::string_view field)
+{
+    double value;
+    if (!parseDouble(field, value)){value = std::numeric_limits<double>::quiet_NaN();};
+    return value;
+};
+
+//integer of a field or missing_int if it is empty
+inline int32_t parseCount(std::string_view field)
+{
+    int value;
+    if (!parseInt(field, value)){return missing_int;};
+    return value;
+};
+
+//epoch seconds of time code YYYYMMDDHHMMSS.sss, fractions of seconds are dropped
+//missing time codes give 0
+inline int64_t epochFromTimeCode(double time_code)
+{
+    if (!(time_code > 0.)){return 0;};
+    int year, month, day, hour, min, sec;
+    splitTimeCode(time_code, year, month, day, hour, min, sec);
+    return epochFromParts(year, month, day, hour, min, sec);
+};
+
+//shortest text that reads back to the same number, never in exponent form for time codes
+//missing values (NaN) are written as empty field like in the csv files
+inline std::string formatNumber(double value)
+{
+    char buf[64];
+    if (std::isnan(value)){return "";};
+    if (std::isinf(value)){return value > 0 ? "inf" : "-inf";};
+    int digits = std::fabs(value) >= 1. ? static_cast<int>(std::log10(std::fabs(value))) + 1 : 1;
+    for (int p = digits < 17 ? digits : 17; p <= 17; p++)
+    {
+        snprintf(buf, sizeof(buf), "%.*g", p, value);
+        if (strtod(buf, nullptr) == value){break;};
+    };
+    return buf;
+};
+
+inline std::string formatNumber(int32_t value)
+{
+    if (value == missing_int){return "";};
+    return std::to_string(value);
+};
+
+#endif
@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////
+// Point decimation for graphs of the Picarro L-2130i tools               //
+// author: Sebastian Stezura // E-Mail: sebastian_stezura@gmx.net         //
+// GitHub: CplusplusB                                                     //
+// version: 1 // date: 17.10.2026                                         //
+////////////////////////////////////////////////////////////////////////////
+
+//a pad can not show more points than it has pixels, so graphs get at most that many points
+//  decimateLTTB      time series, largest triangle three buckets (Steinarsson 2013): the series is cut
+//                    into buckets and the point of every bucket spanning the largest triangle with its
+//                    neighbours is kept, peaks and the shape stay, first and last point are kept
+//  decimateDensity   scatter, the range is cut into cells of about a marker and the first point of
+//                    every cell is kept, outliers stay because their cells are empty otherwise
+//points with a missing value (NaN) are dropped, fits should use the full data
+
+#ifndef DECIMATE_H
+#define DECIMATE_H
+
+#include <vector> //for using vectors
+#include <cmath> //for fabs and isfinite
+#include <cstddef> //for size_t
+
+//finite points only
+inline void finitePoints(const double *x, const double *y, size_t n, std::vector<double> &out_x, std::vector<double> &out_y)
+{
+    out_x.clear();
+    out_y.clear();
+    out_x.reserve(n);
+    out_y.reserve(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        if (!std::isfinite(x[i]) || !std::isfinite(y[i])){continue;};
+        out_x.push_back(x[i]);
+        out_y.push_back(y[i]);
+    };
+};
+
+//at most threshold points of a series sorted by x, threshold < 3 keeps all
+inline void decimateLTTB(const double *x, const double *y, size_t n, size_t threshold, std::vector<double> &out_x, std::vector<double> &out_y)
+{
+    std::vector<double> px, py;
+    finitePoints(x, y, n, px, py);
+    n = px.size();
+    if (threshold < 3 || n <= threshold){out_x.swap(px); out_y.swap(py); return;};
+
+    out_x.clear();
+    out_y.clear();
+    out_x.reserve(threshold);
+    out_y.reserve(threshold);
+    out_x.push_back(px[0]);
+    out_y.push_back(py[0]);
+    //first and last point are kept, the others are cut into threshold-2 buckets
+    double every = static_cast<double>(n - 2) / (threshold - 2);
+    size_t a = 0; //point kept of the bucket before
+    for (size_t b = 0; b < threshold - 2; b++)
+    {
+        size_t begin = static_cast<size_t>(b * every) + 1;
+        size_t end = static_cast<size_t>((b + 1) * every) + 1;
+        if (end > n - 1){end = n - 1;};
+        //mean of the next bucket, for the last bucket the last point
+        size_t next_begin = end;
+        size_t next_end = static_cast<size_t>((b + 2) * every) + 1;
+        if (next_end > n){next_end = n;};
+        if (next_begin >= next_end){next_begin = n - 1; next_end = n;};
+        double mean_x = 0., mean_y = 0.;
+        for (size_t i = next_begin; i < next_end; i++){mean_x += px[i]; mean_y += py[i];};
+        mean_x /= (next_end - next_begin);
+        mean_y /= (next_end - next_begin);
+
+        double max_area = -1.;
+        size_t keep = begin;
+        for (size_t i = begin; i < end; i++)
+        {
+            double area = std::fabs((px[a] - mean_x) * (py[i] - py[a]) - (px[a] - px[i]) * (mean_y - py[a]));
+            if (area > max_area){max_area = area; keep = i;};
+        };
+        out_x.push_back(px[keep]);
+        out_y.push_back(py[keep]);
+        a = keep;
+    };
+    out_x.push_back(px[n-1]);
+    out_y.push_back(py[n-1]);
+};
+
+//first point of every cell of a nx x ny grid over the range of the points, order of the points stays
+inline void decimateDensity(const double *x, const double *y, size_t n, size_t nx, size_t ny, std::vector<double> &out_x, std::vector<double> &out_y)
+{
+    std::vector<double> px, py;
+    finitePoints(x, y, n, px, py);
+    n = px.size();
+    if (nx == 0 || ny == 0 || n <= nx * ny / 16){out_x.swap(px); out_y.swap(py); return;};
+
+    double min_x = px[0], max_x = px[0], min_y = py[0], max_y = py[0];
+    for (size_t i = 1; i < n; i++)
+    {
+        if (px[i] < min_x){min_x = px[i];};
+        if (px[i] > max_x){max_x = px[i];};
+        if (py[i] < min_y){min_y = py[i];};
+        if (py[i] > max_y){max_y = py[i];};
+    };
+    double scale_x = max_x > min_x ? (nx - 1) / (max_x - min_x) : 0.;
+    double scale_y = max_y > min_y ? (ny - 1) / (max_y - min_y) : 0.;
+
+    std::vector<bool> used(nx * ny, 0);
+    out_x.clear();
+    out_y.clear();
+    for (size_t i = 0; i < n; i++)
+    {
+        size_t cell = static_cast<size_t>((py[i] - min_y) * scale_y) * nx + static_cast<size_t>((px[i] - min_x) * scale_x);
+        if (used[cell]){continue;};
+        used[cell] = 1;
+        out_x.push_back(px[i]);
+        out_y.push_back(py[i]);
+    };
+};
+
+#endif
@@ -5,9 +5,14 @@
 // version: 1 // date: 03.01.2022                                         //
 ////////////////////////////////////////////////////////////////////////////
 
-//read data from Standards_eval_end_data_YEAR.txt (standards_eval_corr.cc) and Ambient_data_YEAR.txt (ambient.cc)
+//read data from Standards_eval_end_data_YEAR.txt (standards_eval_corr.cc) and Ambient_data_YEAR.pcol or .txt (ambient.cc)
 //draw Graphs
-//write corrected data to file Ambient_data_YEAR_corr.txt
+//write corrected data to file Ambient_data_YEAR_corr.pcol (column store) and Ambient_data_YEAR_corr.txt
+//"./Eval_air_std.o --stream" reads the Picarro csv files directly in a single pass instead of Ambient_data_YEAR (no ambient.cc needed),
+//"./Eval_air_std.o --stream --noplot" additionally keeps nothing for the Graphs and runs in constant memory
+//"--year YEAR --ambient FILE (or --input DIR with --stream) --standards FILE --output DIR --batch" runs without dialogs, see run_options.h
+//"--years 2018-2022" evaluates the range in one run, Standards of all years calibrate the ambient air across the year ends,
+//the corrected data and the Graphs are written per year like for a single year (year_range.h)
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // compile command:                                                                                                          //
@@ -24,6 +29,33 @@
 //////////////////////////////////////////////////////////////////////////////////
 #include "tinyfiledialogs.h"
 
+//binary column store for the ambient files
+#include "column_store.h"
+//timestamp decoder
+#include "picarro_time.h"
+//Standard lookup for calibration
+#include "calibration.h"
+//csv files of the folder in time order
+#include "file_catalog.h"
+//window means for averaging
+#include "mean_kernel.h"
+//wall clock bins for averaging
+#include "resample.h"
+//streaming mean and spread
+#include "running_stats.h"
+//fewer points for the graphs
+#include "decimate.h"
+//command line and config file options
+#include "run_options.h"
+//drawing in worker processes
+#include "render_queue.h"
+//years of a run
+#include "year_range.h"
+//stage times and counters
+#include "stage_report.h"
+//warnings of the loops over rows
+#include "logger.h"
+
 ////////////////////
 // C/C++ includes //
 ////////////////////
@@ -34,10 +66,13 @@
 #include <fstream> //for reading and writing to files
 #include <sstream> //for reading files
 #include <algorithm> //for different C/C++ functions
+#include <cstdint> //fixed size types
 #include <ctime>  //for time
 #include <execution> //for parallel stuff
 #include <pthread.h> //multithreading
 #include <thread> //multithreading
+#include <memory> //for the stores of the years
+#include <map> //for the stores of the years
 
 /////////////////////////////
 // Root includes see also: //
@@ -45,6 +80,7 @@
 /////////////////////////////
 #include <TMath.h>
 #include <TApplication.h> //showing GUI
+#include <TROOT.h> //batch mode
 #include <TSystem.h> //System functions
 #include <TCanvas.h> //Canvas for Grahps
 #include <TFrame.h> //Frame for Graphs
@@ -183,51 +219,48 @@ double correctH2_hum(double H2O)
     return (d_0-A/10000.)-(d_0-A/H2O);
 };
 
-//get first Datapoint in file
-int getLineRawData(string datapath)
+//skip header of file, stream is at first Datapoint afterwards
+bool skipToRawData(ifstream &inFile)
 {
-    int RawNum;
-    ifstream inFile(datapath);
-    if (inFile.is_open())
+    string line;
+    while (getline(inFile, line))
     {
-        string line;
-        int i = 1;
-        while (getline(inFile, line))
+        if (line == "Raw Data")
         {
-            if (line == "Raw Data")
-            {
-                RawNum = i+3;
-                cout << "Line with first Data is: " << RawNum << endl;
-            };
-            i++;
+            //separator and column names
+            getline(inFile, line);
+            getline(inFile, line);
+            return 1;
         };
     };
-    inFile.close();
-    return RawNum;
+    return 0;
 };
 
 //getting Data from file
-void getData_std(string datapath, vector<Data> &data, string &year)
+void getData_std(string datapath, vector<Data> &data, const YearRange &years)
 {
     string time_r, analysis_r, port_r, identifier_r, ignore_r, inj_nmb_r, H2O_mean_r, H2O_sd_r, O18_r, O18_sd_r, H2_r, H2_sd_r, temp_r, CH4_r, H2O_sl_r, first_r;
     double timer, inj_nmbr, H2O_meanr, H2O_sdr, O18r, O18_sdr, H2r, H2_sdr, CH4r, tempr, H2O_slr;
     TDatime date_code;
+    TimeStamp time_stamp;
     // int ignore;
     //loop over alle files
-    int RawNum = getLineRawData(datapath);
     ifstream inFile(datapath);
     cout << "Reading file at " << datapath << " ..." << endl;
 
     // read signal values from file
-	if (inFile.is_open())
+	if (inFile.is_open() && skipToRawData(inFile))
 	{
-        int i = 1;
+        int i = 0;
         int j = 0;
+        long n_rows = 0, n_slope = 0;
+        LogTally &bad_time = logger.tally("Standard rows with unreadable time code");
+        LogTally &bad_value = logger.tally("Standard rows with unreadable values");
+        LogTally &slope = logger.tally("rows skipped by slope filter");
         string line;
         while (getline(inFile, line))
 		{
-            if (i < RawNum) {i++; continue;};
-            //if (i >= RawNum) {cout << "Here starts data, i = " << i << endl;};
+            n_rows++;
             stringstream stst(line);
             getline(stst,time_r,',');
             getline(stst,analysis_r,',');
@@ -245,27 +278,20 @@ void getData_std(string datapath, vector<Data> &data, string &year)
             getline(stst,CH4_r,',');
             getline(stst,H2O_sl_r,',');
             getline(stst,first_r,',');
-            if(i == RawNum)
+            if(i == 0)
             {
                 cout << " | " << time_r << " | " <<  analysis_r << " | " <<  port_r << " | " <<  identifier_r << " | " <<  ignore_r << " | " << inj_nmb_r << " | " <<  H2O_mean_r << " | " <<  H2O_sd_r << " | " <<  O18_r << " | " <<  O18_sd_r << " | " <<  H2_r << " | " <<  H2_sd_r << " | " <<  temp_r << " | " <<  CH4_r << " | " <<  H2O_sl_r << " | " << endl;
             };
 
-            try
+            //decode time code "YYYYMMDDHHMMSS.sss"
+            if (decodeTimeCode(time_r, time_stamp))
             {
-                date_code.Set
-                (
-                    stoi(time_r.substr(0,4)), //year
-                    stoi(time_r.substr(4,2)), //month
-                    stoi(time_r.substr(6,2)), //day
-                    stoi(time_r.substr(8,2)), //hour
-                    stoi(time_r.substr(10,2)), //minute
-                    stoi(time_r.substr(12,2)) //second
-                );
+                date_code.Set(time_stamp.year, time_stamp.month, time_stamp.day, time_stamp.hour, time_stamp.min, time_stamp.sec);
             }
-            catch (...)
+            else
             {
-                cout << "Time Code: " << time_r << " at " << analysis_r << endl;
-            }
+                bad_time.add("Time Code: ", time_r, " at ", analysis_r);
+            };
 
             try
             {
@@ -283,22 +309,23 @@ void getData_std(string datapath, vector<Data> &data, string &year)
             }
             catch (...)
             {
-                cout << "Time Code: " << time_r << " at " << analysis_r << endl;
+                bad_value.add("Time Code: ", time_r, " at ", analysis_r);
             }
 
 
-            if(i == RawNum)
+            if(i == 0)
             {
-                cout << " | " << time_r << " | " <<  analysis_r << " | " <<  port_r << " | " <<  identifier_r << " | " <<  ignore_r << " | " << inj_nmb_r << " | " <<  H2O_meanr << " | " <<  H2O_sdr << " | " <<  O18r << " | " <<  O18_sdr << " | " <<  H2r << " | " <<  H2_sdr << " | " <<  tempr << " | " <<  CH4r << " | " <<  H2O_slr << " | " << endl;
+                logger.info(" | ", time_r, " | ", analysis_r, " | ", port_r, " | ", identifier_r, " | ", ignore_r, " | ", inj_nmb_r, " | ", H2O_meanr, " | ", H2O_sdr, " | ", O18r, " | ", O18_sdr, " | ", H2r, " | ", H2_sdr, " | ", tempr, " | ", CH4r, " | ", H2O_slr, " | ");
             };
-            if (time_r.substr(0,4) != year){continue;};
+            if (!years.contains(time_stamp.year)){continue;};
             if(H2O_slr > 1.8 || H2O_slr < 1.5)
             {
-                cout << fixed << "Slope not in range at " << timer << endl;
+                slope.add("Slope not in range at ", formatNumber(timer));
+                n_slope++;
                 continue;
             };
 
-            if (j == 0 && data.size() < 1){cout << "|j war 0|"; data.push_back(Data()); data[j].analysis_o = analysis_r;};
+            if (j == 0 && data.size() < 1){logger.flush(); cout << "|j war 0|"; data.push_back(Data()); data[j].analysis_o = analysis_r;};
             if (analysis_r != data[j].analysis_o){j++; data.push_back(Data());};
             data[j].ID_name = identifier_r;
             data[j].analysis_o = analysis_r;
@@ -314,7 +341,7 @@ void getData_std(string datapath, vector<Data> &data, string &year)
             data[j].H2_sd.push_back(H2_sdr);
             data[j].H2O_sl.push_back(H2O_slr);
             data[j].first.push_back(stoi(first_r));
-            data[j].month.push_back(stoi(time_r.substr(4,2)));
+            data[j].month.push_back(time_stamp.month);
 
 
 
@@ -324,27 +351,24 @@ void getData_std(string datapath, vector<Data> &data, string &year)
             };
             i++;
 		};
+        stage_report.count("read standards", "rows read", n_rows);
+        stage_report.count("read standards", "rows of year", i + n_slope);
+        stage_report.count("read standards", "slope out of range", n_slope);
 	};
+    logger.flush();
     cout << "Size of data is: " << data.size() << endl;
     inFile.close();
 
 };
 
 //Getting Average and Standard dev of vector for Standards
+//the first 4 injections carry memory of the sample before and are left out
 void average_stdev(vector<double> &x, double &mean, double &stdev)
 {
-    double mean_t = 0.;
-    double sum = 0.;
-    for(int i = 4; i < x.size(); i++)
-    {
-        mean_t = mean_t + x[i];
-    };
-    mean = mean_t / 6.;
-    for(int i = 4; i < x.size(); i++)
-    {
-        sum = sum + (x[i] - mean)*(x[i] - mean);
-    };
-    stdev = std::sqrt(sum / 5.);
+    RunningStats stats;
+    for(int i = 4; i < x.size(); i++){stats.add(x[i]);};
+    mean = stats.average();
+    stdev = stats.stdev();
 };
 
 //Get all Standard dates for Memory correction of Ambient Air, Averaging Standards
@@ -377,28 +401,87 @@ void getStd_corr(vector<Data> &data)
     };
 };
 
+//getting Ambient Data from column store, columns are used directly from the mapped file
+bool getData_amb_store(string datapath, Data &data, const YearRange &years)
+{
+    StoreReader store(datapath);
+    const double *timed = store.getDouble("Time");
+    const double *H2O_mean = store.getDouble("H2O mean");
+    const double *O18 = store.getDouble("O18");
+    const double *H2 = store.getDouble("H2");
+    if (!store.isOpen() || !timed || !H2O_mean || !O18 || !H2)
+    {
+        cout << "No ambient column store at " << datapath << endl;
+        return 0;
+    };
+    cout << "Reading column store at " << datapath << " with " << store.rows() << " rows ..." << endl;
+    int year_c, month_c, day_c, hour_c, min_c, sec_c;
+    data.timed.reserve(store.rows());
+    data.date.reserve(store.rows());
+    data.H2O_mean.reserve(store.rows());
+    data.O18.reserve(store.rows());
+    data.H2.reserve(store.rows());
+    long n_year = 0, n_missing = 0;
+    LogTally &missing = logger.tally("Ambient rows with missing values");
+    for (uint64_t i = 0; i < store.rows(); i++)
+    {
+        if (!splitTimeCode(timed[i], year_c, month_c, day_c, hour_c, min_c, sec_c))
+        {
+            missing.add("Time Code: ", formatNumber(timed[i]));
+            n_missing++;
+            continue;
+        };
+        if (!years.contains(year_c)){continue;};
+        n_year++;
+        if (std::isnan(H2O_mean[i]) || std::isnan(O18[i]) || std::isnan(H2[i]))
+        {
+            missing.add("Time Code: ", formatNumber(timed[i]));
+            n_missing++;
+            continue;
+        };
+        data.timed.push_back(timed[i]);
+        data.date.push_back(TDatime(year_c, month_c, day_c, hour_c, min_c, sec_c));
+        data.H2O_mean.push_back(H2O_mean[i]);
+        data.O18.push_back(O18[i]+correctO18_hum(H2O_mean[i]));
+        data.H2.push_back(H2[i]+correctH2_hum(H2O_mean[i]));
+    };
+    stage_report.count("read ambient", "rows read", store.rows());
+    stage_report.count("read ambient", "rows of year", n_year);
+    stage_report.count("read ambient", "missing values", n_missing);
+    logger.flush();
+    return 1;
+};
+
 //getting Ambient Data from file and Correct
-void getData_amb(string datapath, Data &data, vector<Data> &data_std, string &year)
+void getData_amb(string datapath, Data &data, vector<Data> &data_std, const YearRange &years)
 {
     string time_r, port_r, H2O_mean_r, O18_r, H2_r;
     double timer, H2O_meanr, O18r, H2r;
     TDatime date_code;
+    TimeStamp time_stamp;
 
-    //loop over alle files
-    int RawNum = getLineRawData(datapath);
+    //written by ambient.cc as column store
+    if (isColumnStore(datapath))
+    {
+        getData_amb_store(datapath, data, years);
+        return;
+    };
+
+    //old text file
     ifstream inFile(datapath);
     cout << "Reading file at " << datapath << " ..." << endl;
 
     // read signal values from file
-	if (inFile.is_open())
+	if (inFile.is_open() && skipToRawData(inFile))
 	{
-        int i = 1;
+        int i = 0;
         int j = 0;
+        long n_rows = 0, n_bad = 0;
+        LogTally &bad_time = logger.tally("Ambient rows with unreadable time code");
         string line;
         while (getline(inFile, line))
 		{
-            if (i < RawNum) {i++; continue;};
-
+            n_rows++;
             stringstream stst(line);
             getline(stst,time_r,',');
             getline(stst,port_r,',');
@@ -407,27 +490,19 @@ void getData_amb(string datapath, Data &data, vector<Data> &data_std, string &ye
             getline(stst,H2_r,',');
 
 
-            try
-            {
-                date_code.Set
-                (
-                    stoi(time_r.substr(0,4)), //year
-                    stoi(time_r.substr(4,2)), //month
-                    stoi(time_r.substr(6,2)), //day
-                    stoi(time_r.substr(8,2)), //hour
-                    stoi(time_r.substr(10,2)),//minutes
-                    stoi(time_r.substr(12,2)) //seconds
-                );
-                timer = stod(time_r);
-            }
-            catch (...)
+            //decode time code "YYYYMMDDHHMMSS.sss"
+            if (!decodeTimeCode(time_r, time_stamp))
             {
-                cout << "Time Code: " << time_r << endl;
-            }
+                bad_time.add("Time Code: ", time_r);
+                n_bad++;
+                continue;
+            };
+            date_code.Set(time_stamp.year, time_stamp.month, time_stamp.day, time_stamp.hour, time_stamp.min, time_stamp.sec);
+            timer = time_stamp.time_code;
 
-            if (time_r.substr(0,4) != year){continue;};
+            if (!years.contains(time_stamp.year)){continue;};
 
-            if(time_r.substr(0,4) == year)
+            if(years.contains(time_stamp.year))
             {
                 H2O_meanr = stod(H2O_mean_r);
                 O18r = stod(O18_r);
@@ -440,134 +515,163 @@ void getData_amb(string datapath, Data &data, vector<Data> &data_std, string &ye
             };
             i++;
 		};
+        stage_report.count("read ambient", "rows read", n_rows);
+        stage_report.count("read ambient", "rows of year", i);
+        stage_report.count("read ambient", "bad time codes", n_bad);
 	};
     inFile.close();
-
+    logger.flush();
 };
 
 //X seconds averaging Data
-void meanXminData(Data &data, Data &data_new)
+void meanXminData(Data &data, Data &data_new, MeanMode mode = mean_block)
 {
-    int i = 0;
-    double mean_H2O, mean_H2, mean_O18;
-    TDatime date_code;
-    double timed;
-    int avetime = 60; //Averaging time for data
-    //string date;
-    cout << "size of data.timed: " << data.timed.size() << endl;
-    while (i < data.timed.size()-avetime)
+    size_t avetime = 60; //Averaging time for data
+    size_t n = data.timed.size();
+    cout << "size of data.timed: " << n << endl;
+    if (n > 0) {cout << "Data " << data.H2O_mean[0] << " " << data.H2[0] << " " << data.O18[0] << endl;};
+
+    size_t count = meanCount(n, avetime, mode);
+    data_new.H2O_mean_mean.resize(count);
+    data_new.H2_mean.resize(count);
+    data_new.O18_mean.resize(count);
+    data_new.timed_mean.resize(count);
+    data_new.date_mean.resize(count);
+    windowMean3(data.H2O_mean.data(), data.H2.data(), data.O18.data(), n, avetime, mode, data_new.H2O_mean_mean.data(), data_new.H2_mean.data(), data_new.O18_mean.data());
+    //time of the middle of the window
+    for (size_t k = 0; k < count; k++)
     {
-        mean_H2O = 0;
-        mean_H2 = 0;
-        mean_O18 = 0;
-        if (i == 0) {cout << "Data " << data.H2O_mean[0] << " " << data.H2[0] << " " << data.O18[0] << endl;};
-
-        for (int j = 0; j < avetime; j++)
-        {
-            mean_H2O = mean_H2O + data.H2O_mean[i+j];
-            mean_H2 = mean_H2 + data.H2[i+j];
-            mean_O18 = mean_O18 + data.O18[i+j];
-            //cout << data.H2O_mean_mean[i] << endl;
-            i++;
-        };
-        // cout << data.date[i-avetime/2].GetDate() << " at " << i << " mean " << mean_H2O/avetime << "|" << mean_H2/avetime << "|" << mean_O18/avetime << endl;
-        mean_H2O = mean_H2O / avetime;
-        mean_H2 = mean_H2 / avetime;
-        mean_O18 = mean_O18 / avetime;
-        date_code = data.date[i-avetime/2];
-        timed = data.timed[i-avetime/2];
-
-        data_new.H2O_mean_mean.push_back(mean_H2O);
-        data_new.H2_mean.push_back(mean_H2);
-        data_new.O18_mean.push_back(mean_O18);
-        data_new.timed_mean.push_back(timed);
-        data_new.date_mean.push_back(date_code);
-        //cout << data.H2O_mean_mean[data.H2O_mean_mean.size()-1] << endl;
-        //cout << data.timed_mean[data.timed_mean.size()-1] << endl;
-        //cout << "size: H2O|timed" << data.H2O_mean_mean.size() << "|" << data.timed_mean.size() << endl;
-
-
+        size_t middle = windowBegin(k, avetime, mode) + avetime/2;
+        data_new.timed_mean[k] = data.timed[middle];
+        data_new.date_mean[k] = data.date[middle];
     };
     cout << "Size of data averaged: " << data_new.timed_mean.size() << endl;
+    stage_report.count("average", "rows", n);
+    stage_report.count("average", "means", count);
 };
 
-//Compare times for Correction
-double compare_dates(double date_amb, vector<double> date_comp, vector<double> corr)
+//averaging over fixed wall clock bins of bin_seconds instead of 60 samples, means never mix data from both sides of a gap
+//the time of a mean is the middle of its bin, count, stdev, min and max of all bins go to End/Ambient_data_YEAR_bins_Ns.pcol
+void binXminData(Data &data, Data &data_new, int64_t bin_seconds, string evalpath, string year)
 {
-    if(date_amb < date_comp[0])
+    //rows without time can not be binned
+    Resampler resampler(bin_seconds, 3);
+    for (size_t i = 0; i < data.timed.size(); i++)
     {
-        return corr[0];
+        if (!(data.timed[i] > 0.)){continue;};
+        double values[3] = {data.H2O_mean[i], data.H2[i], data.O18[i]};
+        resampler.push(epochFromTimeCode(data.timed[i]), values);
     };
-    if(date_amb >= date_comp[date_comp.size()-1])
+    BinnedSeries &bins = resampler.finish();
+    cout << "size of data.timed: " << data.timed.size() << endl;
+
+    size_t count = bins.size();
+    vector<double> time_code(count);
+    data_new.H2O_mean_mean.resize(count);
+    data_new.H2_mean.resize(count);
+    data_new.O18_mean.resize(count);
+    data_new.timed_mean.resize(count);
+    data_new.date_mean.resize(count);
+    int year_c, month_c, day_c, hour_c, min_c, sec_c;
+    for (size_t k = 0; k < count; k++)
     {
-        return corr[corr.size()-1];
+        time_code[k] = timeCodeFromEpoch(bins.begin[k]);
+        civilFromEpoch(bins.begin[k] + bin_seconds/2, year_c, month_c, day_c, hour_c, min_c, sec_c);
+        data_new.timed_mean[k] = timeCodeFromEpoch(bins.begin[k] + bin_seconds/2);
+        data_new.date_mean[k].Set(year_c, month_c, day_c, hour_c, min_c, sec_c);
+        data_new.H2O_mean_mean[k] = bins.stats[0][k].mean;
+        data_new.H2_mean[k] = bins.stats[1][k].mean;
+        data_new.O18_mean[k] = bins.stats[2][k].mean;
     };
-    if(date_amb >= date_comp.front())
+    cout << "Size of data averaged: " << count << " bins of " << bin_seconds << " s" << endl;
+    stage_report.count("average", "rows", data.timed.size());
+    stage_report.count("average", "means", count);
+
+    //all statistics of the bins
+    string OutputFileName = "Ambient_data_" + year + "_bins_" + to_string(bin_seconds) + "s";
+    vector<vector<double>> columns;
+    vector<string> names;
+    vector<string> channels = {"H2O", "H2", "O18"};
+    vector<int64_t> n(count);
+    for (size_t k = 0; k < count; k++){n[k] = bins.stats[0][k].count;};
+    for (size_t c = 0; c < channels.size(); c++)
     {
-        for(int i = 0; i < date_comp.size()-1; i++)
+        vector<double> mean(count), stdev(count), min(count), max(count);
+        for (size_t k = 0; k < count; k++)
         {
-            if(date_amb >= date_comp[i])
-            {
-                if(date_amb < date_comp[i+1])
-                {
-                    return corr[i];
-                };
-            };
+            mean[k] = bins.stats[c][k].mean;
+            stdev[k] = bins.stats[c][k].stdev;
+            min[k] = bins.stats[c][k].min;
+            max[k] = bins.stats[c][k].max;
         };
+        columns.push_back(mean);
+        columns.push_back(stdev);
+        columns.push_back(min);
+        columns.push_back(max);
+        names.push_back(channels[c] + " mean");
+        names.push_back(channels[c] + " sd");
+        names.push_back(channels[c] + " min");
+        names.push_back(channels[c] + " max");
     };
-    return 0.;
-};
-
-//Compare times for Memory
-bool compare_dates_mem(double date_amb, vector<double> date_comp, double skip)
-{
-    for(int i = 0; i < date_comp.size(); i++)
+    StoreWriter store("Ambient bins");
+    time_t t = time(0);
+    store.meta = "Evaluation from: " + string(ctime(&t)) + "Type: Ambient bins of " + to_string(bin_seconds) + " s (uncalibrated)\n\n";
+    store.addDouble("Time", time_code);
+    store.addInt64("Epoch", bins.begin);
+    store.addInt64("Count", n);
+    for (size_t c = 0; c < columns.size(); c++){store.addDouble(names[c], columns[c], 3);};
+    if (!store.write(evalpath + "/End/" + OutputFileName + store_extension))
     {
-        if(date_amb >= date_comp[i] && date_amb < date_comp[i]+skip)
-        {
-            return 1;
-        };
+        cout << "Could not write " << evalpath + "/End/" + OutputFileName + store_extension << endl;
+        return;
     };
-    return 0;
+    StoreReader written(evalpath + "/End/" + OutputFileName + store_extension);
+    written.exportText(evalpath + "/End/" + OutputFileName + ".txt");
+    cout << "Output Files: " << OutputFileName + store_extension << " and " << OutputFileName + ".txt" << endl;
 };
 
-//Memory Correction and Calibration of Ambient Air
-void memcorr_amb(Data &data_amb_mean, Data &data_amb_corr, vector<Data> &data)
+//collect Standard dates and values from getStd_corr
+void getCalibration(vector<Data> &data, Calibration &calib)
 {
-    vector<double> std_date;
-    vector<double> std_date_corr, O18_corr_r, H2_corr_r;
-    double skip = 300.;
-    double O18_corr = 0.; //value of Standard measured
-    double H2_corr = 0.; //value of Standard measured
-    double O18_true = -8.65; //O18 Value of Standard
-    double H2_true = -61.55; //H2 value of Standard
-
     for(int i = 0; i < data.size(); i++)
     {
-        std_date.push_back(data[i].timed_corr_all);
+        calib.std_date.push_back(data[i].timed_corr_all);
         if(data[i].corr == 1)
         {
-            std_date_corr.push_back(data[i].timed_corr);
-            O18_corr_r.push_back(data[i].O18_corr);
-            H2_corr_r.push_back(data[i].H2_corr);
+            calib.std_date_corr.push_back(data[i].timed_corr);
+            calib.O18_corr_r.push_back(data[i].O18_corr);
+            calib.H2_corr_r.push_back(data[i].H2_corr);
         };
     };
+    calib.sort();
     int l = 0;
-    for(int i = 0; i < std_date_corr.size(); i++)
+    for(int i = 0; i < calib.std_date_corr.size(); i++)
     {
-        cout << "Correction vector true: " << std_date_corr[i] << "||" << O18_corr_r[i] << "||" << H2_corr_r[i] << endl;
+        cout << "Correction vector true: " << calib.std_date_corr[i] << "||" << calib.O18_corr_r[i] << "||" << calib.H2_corr_r[i] << endl;
         if(l == 0)
         {
-            cout << "Correction vector true last: " << std_date_corr[std_date_corr.size()-1] << "||" << O18_corr_r[O18_corr_r.size()-1] << "||" << H2_corr_r[H2_corr_r.size()-1] << endl;
+            cout << "Correction vector true last: " << calib.std_date_corr[calib.std_date_corr.size()-1] << "||" << calib.O18_corr_r[calib.O18_corr_r.size()-1] << "||" << calib.H2_corr_r[calib.H2_corr_r.size()-1] << endl;
             l++;
         };
 
     };
-    cout << "Correction vectors count: " << std_date_corr.size() << endl;
+    cout << "Correction vectors count: " << calib.std_date_corr.size() << endl;
+};
+
+//Memory Correction and Calibration of Ambient Air
+void memcorr_amb(Data &data_amb_mean, Data &data_amb_corr, vector<Data> &data)
+{
+    Calibration calib;
+    double O18_corr = 0.; //value of Standard measured
+    double H2_corr = 0.; //value of Standard measured
+
+    getCalibration(data, calib);
+    DateIndex mem_index(calib.std_date), corr_index(calib.std_date_corr);
+    long skipped = 0;
     for(int i = 0; i < data_amb_mean.timed_mean.size(); i++)
     {
 
-        if(compare_dates_mem(data_amb_mean.timed_mean[i], std_date,skip)){cout << "Skipped" << endl; continue;};
+        if(compare_dates_mem(data_amb_mean.timed_mean[i], mem_index, calib.skip)){skipped++; continue;};
         //cout << endl;
         data_amb_corr.timed_mean.push_back(data_amb_mean.timed_mean[i]);
         data_amb_corr.date_mean.push_back(data_amb_mean.date_mean[i]);
@@ -578,6 +682,9 @@ void memcorr_amb(Data &data_amb_mean, Data &data_amb_corr, vector<Data> &data)
         data_amb_corr.timed_mean_conv.push_back(data_amb_mean.date_mean[i].Convert());
 
     };
+    cout << "Skipped " << skipped << " of " << data_amb_mean.timed_mean.size() << " means after Standards (memory)" << endl;
+    stage_report.count("memcorr", "means", data_amb_mean.timed_mean.size());
+    stage_report.count("memcorr", "memory skipped", skipped);
 
     for(int i = 0; i < data_amb_corr.timed_mean.size(); i++)
     {
@@ -588,14 +695,186 @@ void memcorr_amb(Data &data_amb_mean, Data &data_amb_corr, vector<Data> &data)
     // Standard per Standard correction
     for(int i = 0; i < data_amb_corr.timed_mean.size(); i++)
     {
-        O18_corr = compare_dates(data_amb_corr.timed_mean[i], std_date_corr, O18_corr_r) - O18_true;
-        H2_corr = compare_dates(data_amb_corr.timed_mean[i], std_date_corr, H2_corr_r) - H2_true;
+        O18_corr = compare_dates(data_amb_corr.timed_mean[i], corr_index, calib.O18_corr_r) - calib.O18_true;
+        H2_corr = compare_dates(data_amb_corr.timed_mean[i], corr_index, calib.H2_corr_r) - calib.H2_true;
         data_amb_corr.O18_mean[i] = data_amb_corr.O18_mean[i] - O18_corr;
         data_amb_corr.H2_mean[i] = data_amb_corr.H2_mean[i] - H2_corr;
         data_amb_corr.D_excess.push_back(data_amb_corr.H2_mean[i] - 8. * data_amb_corr.O18_mean[i]);
     };
 };
 
+//Ambient_data_YEAR_corr.pcol of every year of the range, a row goes to the store of its year
+class YearStores
+{
+public:
+    YearStores(const YearRange &years, string evalpath)
+    {
+        for (int year : years.list())
+        {
+            paths_[year] = evalpath + "/End/Ambient_data_" + to_string(year) + "_corr";
+            cout << "Writing Data amb corrected to: " << paths_[year] << store_extension << endl;
+            stores_[year].reset(new StoreRowWriter("Ambient corrected", paths_[year] + store_extension, {"Time", "O18", "H2", "Dexcess", "H2O"}, {3, 3, 3, 3, 3}));
+        };
+    };
+
+    bool isOpen() const
+    {
+        for (auto &store : stores_){if (!store.second->isOpen()){return 0;};};
+        return 1;
+    };
+    void push(const double *row)
+    {
+        auto itr = stores_.find(yearOfTimeCode(row[0]));
+        if (itr != stores_.end()){itr->second->push(row);};
+    };
+    //closes every store and exports its .txt, false if one could not be written
+    bool close()
+    {
+        bool ok = 1;
+        for (auto &store : stores_)
+        {
+            const string &path = paths_[store.first];
+            if (!store.second->close())
+            {
+                cout << "Could not write " << path + store_extension << endl;
+                ok = 0;
+                continue;
+            };
+            StoreReader written(path + store_extension);
+            written.exportText(path + ".txt");
+        };
+        return ok;
+    };
+
+private:
+    map<int, unique_ptr<StoreRowWriter>> stores_;
+    map<int, string> paths_; //without extension
+};
+
+//single pass evaluation of Ambient Air, same steps as meanXminData and memcorr_amb
+//rows are humidity corrected by the caller, averaged in blocks of 60, skipped or calibrated
+//and written row by row, only the current block is held in memory
+class AmbientStream
+{
+public:
+    uint64_t rows_in = 0, blocks = 0, skipped = 0;
+
+    //keep is filled like data_amb_corr for the Graphs, nullptr for constant memory
+    AmbientStream(const Calibration &calib, YearStores &out, Data *keep = nullptr) : calib_(calib), mem_index_(calib.std_date), corr_index_(calib.std_date_corr), out_(out), keep_(keep){};
+
+    void push(double timed, double H2O, double O18, double H2)
+    {
+        H2O_[n_] = H2O;
+        H2_[n_] = H2;
+        O18_[n_] = O18;
+        if (n_ == avetime_/2){timed_ = timed;};
+        n_++;
+        rows_in++;
+        if (n_ == avetime_){n_ = 0; emit();};
+    };
+
+    //rows of an incomplete last block are dropped like in meanXminData
+    void finish()
+    {
+        cout << "size of data.timed: " << rows_in << endl;
+        cout << "Size of data averaged: " << blocks << endl;
+        cout << "Size of Data corrected: " << blocks - skipped << endl;
+        cout << "Skipped " << skipped << " of " << blocks << " means after Standards (memory)" << endl;
+        stage_report.count("stream", "rows", rows_in);
+        stage_report.count("stream", "means", blocks);
+        stage_report.count("stream", "memory skipped", skipped);
+    };
+
+private:
+    void emit()
+    {
+        //same kernel as meanXminData
+        double H2O, H2, O18;
+        windowSum3(H2O_, H2_, O18_, avetime_, H2O, H2, O18);
+        H2O = H2O / avetime_;
+        H2 = H2 / avetime_;
+        O18 = O18 / avetime_;
+        blocks++;
+        if(compare_dates_mem(timed_, mem_index_, calib_.skip)){skipped++; return;};
+
+        //D-excess before calibration, written like in writeData
+        double D_excess = H2 - 8. * O18;
+        O18 = O18 - (compare_dates(timed_, corr_index_, calib_.O18_corr_r) - calib_.O18_true);
+        H2 = H2 - (compare_dates(timed_, corr_index_, calib_.H2_corr_r) - calib_.H2_true);
+        double row[5] = {timed_, O18, H2, D_excess, H2O};
+        out_.push(row);
+
+        if (keep_)
+        {
+            int year_c, month_c, day_c, hour_c, min_c, sec_c;
+            splitTimeCode(timed_, year_c, month_c, day_c, hour_c, min_c, sec_c);
+            TDatime date_code(year_c, month_c, day_c, hour_c, min_c, sec_c);
+            keep_->timed_mean.push_back(timed_);
+            keep_->date_mean.push_back(date_code);
+            keep_->H2O_mean.push_back(H2O);
+            keep_->O18_mean.push_back(O18);
+            keep_->H2_mean.push_back(H2);
+            keep_->month.push_back(month_c);
+            keep_->timed_mean_conv.push_back(date_code.Convert());
+            keep_->D_excess.push_back(D_excess);
+        };
+    };
+
+    const Calibration &calib_;
+    DateIndex mem_index_, corr_index_;
+    YearStores &out_;
+    Data *keep_;
+    static const int avetime_ = 60; //Averaging time for data
+    int n_ = 0;
+    double H2O_[avetime_], H2_[avetime_], O18_[avetime_]; //current block
+    double timed_ = 0;
+};
+
+//Picarro csv files of a folder sorted by the date in their names (see file_catalog.h)
+void getFiles_csv(string afilepath, vector<string> &adresses)
+{
+    FileCatalog catalog(afilepath, ".csv");
+    for (int i = 0; i < catalog.size(); i++)
+    {
+        cout << i << ". " << catalog[i].path << endl;
+        adresses.push_back(catalog[i].path);
+    };
+};
+
+//stream Ambient rows of one Picarro csv file, memory correction like ambient.cc and humidity correction like getData_amb
+void streamData_csv(string files_adress, const YearRange &years, AmbientStream &stream)
+{
+    MemoryFilter memory;
+    MappedFile inFile(files_adress);
+    cout << "Reading file " << files_adress << " ..." << endl;
+    if (!inFile.isOpen()){return;};
+    string_view field[picarro_columns];
+    string_view text = inFile.view();
+    string_view line;
+    TimeStamp time_stamp;
+    LogTally &bad_row = logger.tally("Ambient rows with unreadable time code or values");
+    //header
+    nextLine(text, line);
+    while (nextLine(text, line))
+    {
+        splitFields(line, ',', field, picarro_columns);
+        bool ambient = field[col_port] == "Ambient";
+        if (!memory.keep(ambient, field[col_gas_conf] == "H2O")){continue;};
+
+        double H2O_meanr = parseValue(field[col_H2Ov_mean]);
+        double O18r = parseValue(field[col_O18v]);
+        double H2r = parseValue(field[col_H2v]);
+        if (!decodeTimestamp(field[col_time_code], time_stamp) || std::isnan(H2O_meanr) || std::isnan(O18r) || std::isnan(H2r))
+        {
+            bad_row.add("Time Code: ", field[col_time_code], " at ", field[col_time_mean]);
+            continue;
+        };
+        if (!years.contains(time_stamp.year)){continue;};
+        stream.push(time_stamp.time_code, H2O_meanr, O18r+correctO18_hum(H2O_meanr), H2r+correctH2_hum(H2O_meanr));
+    };
+    logger.flush();
+};
+
 //draw Graphs Yearplots
 void drawGraphYear(Data &data_amb, string evalpath, string year)
 {
@@ -631,6 +910,16 @@ void drawGraphYear(Data &data_amb, string evalpath, string year)
     59 //second
     );
 
+    //a pad shows at most one point per pixel column, a marker covers about 4x4 pixels
+    vector<double> x_O18, y_O18, x_H2, y_H2, x_Dex, y_Dex, x_H2O, y_H2O, x_LMWL, y_LMWL;
+    size_t n_mean = data_amb.timed_mean.size();
+    decimateLTTB(data_amb.timed_mean_conv.data(), data_amb.O18_mean.data(), n_mean, width, x_O18, y_O18);
+    decimateLTTB(data_amb.timed_mean_conv.data(), data_amb.H2_mean.data(), n_mean, width, x_H2, y_H2);
+    decimateLTTB(data_amb.timed_mean_conv.data(), data_amb.D_excess.data(), n_mean, width, x_Dex, y_Dex);
+    decimateLTTB(data_amb.timed_mean_conv.data(), data_amb.H2O_mean.data(), n_mean, width, x_H2O, y_H2O);
+    decimateDensity(data_amb.O18_mean.data(), data_amb.H2_mean.data(), data_amb.O18_mean.size(), width/4, height/4, x_LMWL, y_LMWL);
+    cout << "Points drawn of " << n_mean << ": " << x_O18.size() << " per year graph, " << x_LMWL.size() << " in LMWL" << endl;
+
     TCanvas *cYear = new TCanvas("Year","Year",0,0,width,height*4);
 
     cYear->Divide(1,4,0,0);
@@ -638,7 +927,7 @@ void drawGraphYear(Data &data_amb, string evalpath, string year)
     cYear->GetFrame()->SetBorderSize(12);
     cYear->SetGrid();
 
-    TGraph *grO18 = new TGraph(data_amb.timed_mean.size(),data_amb.timed_mean_conv.data(),data_amb.O18_mean.data());
+    TGraph *grO18 = new TGraph(x_O18.size(),x_O18.data(),y_O18.data());
     grO18->SetTitle(O18title.c_str());
     grO18->SetMarkerStyle(43);
     grO18->SetMarkerColor(kBlack);
@@ -656,7 +945,7 @@ void drawGraphYear(Data &data_amb, string evalpath, string year)
 
     cYear->cd(2);
 
-    TGraph *grH2 = new TGraph(data_amb.timed_mean.size(),data_amb.timed_mean_conv.data(),data_amb.H2_mean.data());
+    TGraph *grH2 = new TGraph(x_H2.size(),x_H2.data(),y_H2.data());
     grH2->SetTitle(H2title.c_str());
     grH2->SetMarkerStyle(43);
     grH2->SetMarkerColor(kGreen);
@@ -675,7 +964,7 @@ void drawGraphYear(Data &data_amb, string evalpath, string year)
     cYear->cd(3);
 
 
-    TGraph *grDex = new TGraph(data_amb.timed_mean.size(),data_amb.timed_mean_conv.data(),data_amb.D_excess.data());
+    TGraph *grDex = new TGraph(x_Dex.size(),x_Dex.data(),y_Dex.data());
     grDex->SetTitle(Dextitle.c_str());
     grDex->SetMarkerStyle(43);
     grDex->SetMarkerColor(kOrange);
@@ -693,7 +982,7 @@ void drawGraphYear(Data &data_amb, string evalpath, string year)
     cYear->Update();
 
     cYear->cd(4);
-    TGraph *grH2O = new TGraph(data_amb.timed_mean.size(),data_amb.timed_mean_conv.data(),data_amb.H2O_mean.data());
+    TGraph *grH2O = new TGraph(x_H2O.size(),x_H2O.data(),y_H2O.data());
     grH2O->SetTitle(H2Otitle.c_str());
     grH2O->SetMarkerStyle(43);
     grH2O->SetMarkerColor(kBlue);
@@ -717,7 +1006,9 @@ void drawGraphYear(Data &data_amb, string evalpath, string year)
     cLMWL->GetFrame()->SetBorderSize(12);
     cLMWL->SetGrid();
 
-    TGraph *grLMWL = new TGraph(data_amb.O18_mean.size(),data_amb.O18_mean.data(),data_amb.H2_mean.data());
+    TGraph *grLMWL = new TGraph(x_LMWL.size(),x_LMWL.data(),y_LMWL.data());
+    //the line is fitted to all means
+    TGraph *grFit = new TGraph(data_amb.O18_mean.size(),data_amb.O18_mean.data(),data_amb.H2_mean.data());
     grLMWL->SetTitle(LMWLtitle.c_str());
     grLMWL->SetMarkerStyle(43);
     grLMWL->SetMarkerColor(kBlue);
@@ -730,8 +1021,8 @@ void drawGraphYear(Data &data_amb, string evalpath, string year)
     TF1 *linFit = new TF1("f1", "pol1", -1000., 100.);
 
     linFit->SetParameters(8.,10.);
-    grLMWL->Fit(linFit);
-    linFit = grLMWL->GetFunction("f1");
+    grFit->Fit(linFit, "0");
+    linFit = grFit->GetFunction("f1");
 
     cout << "Parameter Intercept (0): " << linFit->GetParameter(0) << "+-" << linFit->GetParError(0) << endl;
     cout << "Parameter Slope (1): " << linFit->GetParameter(1) << "+-" << linFit->GetParError(1) << endl;
@@ -739,6 +1030,7 @@ void drawGraphYear(Data &data_amb, string evalpath, string year)
     linFit->SetLineColor(kRed);
     linFit->SetLineStyle(4);
     linFit->SetLineWidth(12);
+    linFit->Draw("SAME");
 
     cLMWL->Update();
     gPad->Update();
@@ -862,71 +1154,243 @@ void drawStdGraph(vector<Data> &data_std, string evalpath, string year)
 };
 
 //Write amb Data to file
+//Ambient_data_YEAR_corr.pcol is read by ambient_eval_meteo.cc, the .txt is exported from it
 void writeData(Data &data_amb, string evalpath, string year)
 {
     string OutputFileName;
-    OutputFileName = "Ambient_data_" + year + "_corr.txt";
-    ofstream outFile (evalpath + "/End/" + OutputFileName);
-    outFile << "Time," << "O18," << "H2," << "Dexcess," << "H2O" << endl;
-    cout << "Writing Data amb corrected to: " << OutputFileName << endl;
+    OutputFileName = "Ambient_data_" + year + "_corr";
+    cout << "Writing Data amb corrected to: " << OutputFileName << store_extension << endl;
+
+    //D_excess holds more values than the other columns (see memcorr_amb), first ones are written
+    size_t n = data_amb.timed_mean.size();
+    vector<double> D_excess(data_amb.D_excess.begin(), data_amb.D_excess.begin() + min(n, data_amb.D_excess.size()));
+
+    StoreWriter store("Ambient corrected");
+    store.addDouble("Time", data_amb.timed_mean, 3);
+    store.addDouble("O18", data_amb.O18_mean, 3);
+    store.addDouble("H2", data_amb.H2_mean, 3);
+    store.addDouble("Dexcess", D_excess, 3);
+    store.addDouble("H2O", data_amb.H2O_mean, 3);
+    if (!store.write(evalpath + "/End/" + OutputFileName + store_extension))
+    {
+        cout << "Could not write " << evalpath + "/End/" + OutputFileName + store_extension << endl;
+        return;
+    };
+    StoreReader written(evalpath + "/End/" + OutputFileName + store_extension);
+    written.exportText(evalpath + "/End/" + OutputFileName + ".txt");
+};
+
+
+//single pass from Picarro csv files to Ambient_data_YEAR_corr of every year, only the Standards are held in memory
+void streamAmbient(vector<string> &files_adress, vector<Data> &data_std, Data &data_amb_corr, bool plots, string evalpath, const YearRange &years)
+{
+    Calibration calib;
+    getCalibration(data_std, calib);
+
+    YearStores stores(years, evalpath);
+    if (!stores.isOpen())
+    {
+        cout << "Could not write the corrected data to " << evalpath + "/End" << endl;
+        return;
+    };
+    AmbientStream stream(calib, stores, plots ? &data_amb_corr : nullptr);
+    for (int i = 0; i < files_adress.size(); i++)
+    {
+        streamData_csv(files_adress[i], years, stream);
+    };
+    stage_report.count("stream", "files", files_adress.size());
+    stream.finish();
+    stores.close();
+};
+
+//means of the rows of one year for the Graphs and writeData
+Data yearPart(Data &data, const vector<size_t> &rows)
+{
+    Data part;
+    part.timed_mean = pickRows(data.timed_mean, rows);
+    part.date_mean = pickRows(data.date_mean, rows);
+    part.timed_mean_conv = pickRows(data.timed_mean_conv, rows);
+    part.H2O_mean = pickRows(data.H2O_mean, rows);
+    part.O18_mean = pickRows(data.O18_mean, rows);
+    part.H2_mean = pickRows(data.H2_mean, rows);
+    part.D_excess = pickRows(data.D_excess, rows);
+    part.month = pickRows(data.month, rows);
+    return part;
+};
 
-    for (int j = 0; j < data_amb.timed_mean.size(); j++)
+//Standards corrected in the year
+vector<Data> yearStandards(vector<Data> &data_std, int year)
+{
+    vector<Data> part;
+    for (int i = 0; i < data_std.size(); i++)
     {
-        outFile << fixed << setprecision(3) << data_amb.timed_mean[j] << "," << data_amb.O18_mean[j] << "," << data_amb.H2_mean[j] << "," << data_amb.D_excess[j] << "," << data_amb.H2O_mean[j] << endl;
+        if (data_std[i].corr == 1 && yearOfTimeCode(data_std[i].timed_corr) == year){part.push_back(data_std[i]);};
     };
+    return part;
 };
 
+//Graphs and corrected data of every year of the range, a single year is written without copy
+void writeYears(Data &data_amb_corr, vector<Data> &data_std, const YearRange &years, bool plots, bool write, string evalpath, RenderQueue &render)
+{
+    map<int, vector<size_t>> rows;
+    if (!years.single()){rows = rowsByYear(data_amb_corr.timed_mean, years);};
+    for (int year : years.list())
+    {
+        string name = to_string(year);
+        Data part;
+        vector<Data> part_std;
+        Data *amb = &data_amb_corr;
+        vector<Data> *standards = &data_std;
+        if (!years.single())
+        {
+            part = yearPart(data_amb_corr, rows[year]);
+            part_std = yearStandards(data_std, year);
+            amb = &part;
+            standards = &part_std;
+            cout << "Year " << year << ": " << part.timed_mean.size() << " means, " << part_std.size() << " Standards" << endl;
+        };
+        //a worker sees the data as it is now, the parts can go when the loop goes on
+        if (plots && amb->timed_mean.size() > 0){render.submit("year " + name, [&]{drawGraphYear(*amb, evalpath, name);});};
+        render.submit("standards " + name, [&]{drawStdGraph(*standards, evalpath, name);});
+        if (write)
+        {
+            auto timer = stage_report.time("write");
+            writeData(*amb, evalpath, name);
+            stage_report.count("write", "rows written", amb->timed_mean.size());
+        };
+    };
+};
 
 int main(int argc, char* argv[])
 {
+    RunOptions options(argc, argv,
+        "  --year YEAR        year to evaluate\n"
+        "  --years FIRST-LAST all years of the range in one run, written per year\n"
+        "  --ambient FILE     Ambient_data_YEAR.pcol or .txt of ambient.cc\n"
+        "  --stream           read the csv files directly instead of --ambient\n"
+        "  --input DIR        folder with csv files for --stream\n"
+        "  --noplot           no Graphs of the ambient air with --stream\n"
+        "  --standards FILE   Standards_eval_end_data_YEAR.txt of standards_eval_corr.cc\n"
+        "  --output DIR       folder for evaluation\n"
+        "  --sliding          sliding 60 sample means (one per sample) instead of blocks, not with --stream\n"
+        "  --bin SECONDS      means over wall clock bins (60, 600, 3600, 86400, ...) instead of 60 samples, not with --stream\n"
+        "  --render N         figures drawn at the same time in worker processes (default all cores, 1 draws here)\n");
+    bool stream = options.flag("stream");
+    MeanMode mean_mode = options.flag("sliding") ? mean_sliding : mean_block;
+    int64_t bin_seconds = options.number("bin", 0);
+    if (stream && (mean_mode == mean_sliding || bin_seconds > 0)){cout << "--sliding and --bin are not available with --stream, using blocks" << endl;};
+    bool plots = !options.flag("noplot");
+    stage_report.setProgram("eval_air_std");
     //////////////////////////////////
     // Name, date and path to files //
     //////////////////////////////////
-    string year;
-    cout << "Which year?" << endl;
-    cin >> year;
+    YearRange years = options.years();
+    string year = years.label();
     char const * lFilterPatterns[1]={"*.txt"};
-    string datapath_amb = tinyfd_openFileDialog("Choose File with Ambient data", ".", 1, lFilterPatterns, NULL, 0);
-    cout << "Data Ambient file: " << datapath_amb << endl;
-    string datapath_std = tinyfd_openFileDialog("Choose File with Standard data", ".", 1, lFilterPatterns, NULL, 0);
+    char const * lFilterPatternsAmb[2]={"*.pcol", "*.txt"};
+    string datapath_amb;
+    vector<string> files_adress;
+    if (stream)
+    {
+        datapath_amb = options.selectFolder("input", "Choose Folder with csv Files");
+        cout << "Data Ambient folder: " << datapath_amb << endl;
+        getFiles_csv(datapath_amb, files_adress);
+    }
+    else
+    {
+        datapath_amb = options.openFile("ambient", "Choose File with Ambient data", 2, lFilterPatternsAmb);
+        cout << "Data Ambient file: " << datapath_amb << endl;
+    };
+    string datapath_std = options.openFile("standards", "Choose File with Standard data", 1, lFilterPatterns);
     cout << "Data Standard file: " << datapath_std << endl;
 
     //choose directory for evaluation data
-    string evalpath = tinyfd_selectFolderDialog("Choose Folder for Evaluation", ".");
+    string evalpath = options.selectFolder("output", "Choose Folder for Evaluation");
     cout << "Evalpath " << evalpath << endl;
+    stage_report.info("year", year);
+    stage_report.info("ambient", datapath_amb);
+    stage_report.info("standards", datapath_std);
+    stage_report.info("mode", stream ? "stream" : bin_seconds > 0 ? "bin " + to_string(bin_seconds) + " s" : mean_mode == mean_sliding ? "sliding" : "block");
+    string report = options.get("report", evalpath + "/End/Ambient_" + year + "_eval_report");
 
     //////////////////////////////////////////////////
     // Read files and store values //
     //////////////////////////////////////////////////
     Data data_amb, data_amb_mean, data_amb_corr;
     vector<Data> data_std;
+    //figures are drawn in the background while the program goes on
+    RenderQueue render(options.number("render", 0));
+    if (render.workers() > 1){gROOT->SetBatch(kTRUE);};
     cout << "################" << endl;
     cout << "Reading Standard data ...." << endl;
-    getData_std(datapath_std, data_std, year);
+    {
+        auto timer = stage_report.time("read standards");
+        getData_std(datapath_std, data_std, years);
+    };
     cout << "Finished." << endl;
     cout << "Averaging and Correcting Standard data ...." << endl;
-    getStd_corr(data_std);
+    {
+        auto timer = stage_report.time("correct standards");
+        getStd_corr(data_std);
+        stage_report.count("correct standards", "Standards", data_std.size());
+    };
     cout << "Size of Std Data: " << data_std.size() << endl;
+
+    if (stream)
+    {
+        cout << "Finished." << endl << "################" << endl << "Streaming Ambient Air data ..." << endl;
+        {
+            auto timer = stage_report.time("stream");
+            streamAmbient(files_adress, data_std, data_amb_corr, plots, evalpath, years);
+        };
+        cout << "Finished." << endl;
+        {
+            //the figures are drawn by workers, this is the time until the last one is done
+            auto timer = stage_report.time("draw");
+            writeYears(data_amb_corr, data_std, years, plots, 0, evalpath, render);
+            render.wait();
+            stage_report.count("draw", "figures", render.submitted());
+        };
+        logger.summary();
+        stage_report.write(report);
+        return 0;
+    };
+
     cout << "Finished." << endl << "################" << endl << "Reading Ambient Air data ..." << endl;
-    getData_amb(datapath_amb, data_amb, data_std, year);
+    {
+        auto timer = stage_report.time("read ambient");
+        getData_amb(datapath_amb, data_amb, data_std, years);
+    };
 
     cout << "Finieshed." << endl << "################" << endl << "Averaging Ambient Air" << endl;
-    meanXminData(data_amb, data_amb_mean);
+    {
+        auto timer = stage_report.time("average");
+        if (bin_seconds > 0){binXminData(data_amb, data_amb_mean, bin_seconds, evalpath, year);}
+        else {meanXminData(data_amb, data_amb_mean, mean_mode);};
+    };
     cout << "Finished." << endl;
     data_amb.Destroy();
     cout << "Old Ambient Air destroyed." << endl;
     cout << "################" << endl << "Clearing Ambient Air from Memory..." << endl;
-    memcorr_amb(data_amb_mean, data_amb_corr, data_std);
+    {
+        auto timer = stage_report.time("memcorr");
+        memcorr_amb(data_amb_mean, data_amb_corr, data_std);
+    };
     cout << "Finished." << endl;
     cout << "Size of Data corrected: " << data_amb_corr.timed_mean.size() << endl;
     data_amb_mean.Destroy();
 
-    drawGraphYear(data_amb_corr, evalpath, year);
-    drawStdGraph(data_std, evalpath, year);
-    writeData(data_amb_corr, evalpath, year);
+    //the figures are drawn by workers while the data is written, draw is the time until the last one is done
+    auto draw_timer = stage_report.time("draw");
+    writeYears(data_amb_corr, data_std, years, 1, 1, evalpath, render);
+    render.wait();
+    draw_timer.stop();
+    stage_report.count("draw", "figures", render.submitted());
+    logger.summary();
+    stage_report.write(report);
 
 
 
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////
+// Catalog of the csv files of a Picarro L-2130i folder                   //
+// author: Sebastian Stezura // E-Mail: sebastian_stezura@gmx.net         //
+// GitHub: CplusplusB                                                     //
+// version: 1 // date: 17.10.2026                                         //
+////////////////////////////////////////////////////////////////////////////
+
+//files of a folder as small handles sorted by the start time in their names
+//the time is read once from the name, sorting only moves the handles,
+//the parsed data of file i goes into slot i of a vector with one entry per file,
+//so any number of files works and nothing has to be sorted or copied afterwards
+
+#ifndef FILE_CATALOG_H
+#define FILE_CATALOG_H
+
+#include <string> //for using strings
+#include <vector> //for using vectors
+#include <algorithm> //for sorting
+#include <filesystem> //for reading the folder
+#include <cstdint> //fixed size types
+
+//one file of the folder
+struct FileHandle
+{
+    std::string name; //file name without folder
+    std::string path;
+    int64_t start = -1; //YYYYMMDDhhmmss from the name, -1 if the name has no time
+};
+
+//start time of a Picarro file name "XXXXXXXX-XXX-XXX-YYYYMMDD-hhmmss...", date at 18 and time at 27
+inline int64_t startFromName(const std::string &name)
+{
+    if (name.size() < 33){return -1;};
+    int64_t start = 0;
+    for (size_t i = 18; i < 33; i++)
+    {
+        if (i == 26){continue;};
+        if (name[i] < '0' || name[i] > '9'){return -1;};
+        start = start*10 + (name[i] - '0');
+    };
+    return start;
+};
+
+class FileCatalog
+{
+public:
+    FileCatalog(){};
+    FileCatalog(const std::string &folder, const std::string &extension = ".csv"){scan(folder, extension);};
+
+    //add all files of folder ending with extension, returns number of files added
+    size_t scan(const std::string &folder, const std::string &extension = ".csv")
+    {
+        size_t before = files_.size();
+        std::error_code ec;
+        for (std::filesystem::directory_iterator itr(folder, ec), end; !ec && itr != end; itr.increment(ec))
+        {
+            if (!itr->is_regular_file(ec)){continue;};
+            FileHandle file;
+            file.name = itr->path().filename().string();
+            if (file.name.size() < extension.size() || file.name.compare(file.name.size()-extension.size(), extension.size(), extension) != 0){continue;};
+            file.path = itr->path().string();
+            file.start = startFromName(file.name);
+            files_.push_back(std::move(file));
+        };
+        sort();
+        return files_.size() - before;
+    };
+
+    //by start time, files without time in the name at the end, same time by name
+    void sort()
+    {
+        std::sort(files_.begin(), files_.end(), [](const FileHandle &a, const FileHandle &b)
+        {
+            if ((a.start < 0) != (b.start < 0)){return b.start < 0;};
+            if (a.start != b.start){return a.start < b.start;};
+            return a.name < b.name;
+        });
+    };
+
+    size_t size() const {return files_.size();};
+    bool empty() const {return files_.empty();};
+    const FileHandle &operator[](size_t i) const {return files_[i];};
+    std::vector<FileHandle>::const_iterator begin() const {return files_.begin();};
+    std::vector<FileHandle>::const_iterator end() const {return files_.end();};
+
+    std::vector<std::string> names() const
+    {
+        std::vector<std::string> names;
+        names.reserve(files_.size());
+        for (size_t i = 0; i < files_.size(); i++){names.push_back(files_[i].name);};
+        return names;
+    };
+    std::vector<std::string> paths() const
+    {
+        std::vector<std::string> paths;
+        paths.reserve(files_.size());
+        for (size_t i = 0; i < files_.size(); i++){paths.push_back(files_[i].path);};
+        return paths;
+    };
+
+private:
+    std::vector<FileHandle> files_;
+};
+
+#endif
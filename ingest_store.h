@@ -0,0 +1,189 @@
+////////////////////////////////////////////////////////////////////////////
+// Incremental reading of Picarro L-2130i csv folders                     //
+// author: Sebastian Stezura // E-Mail: sebastian_stezura@gmx.net         //
+// GitHub: CplusplusB                                                     //
+// version: 1 // date: 17.10.2026                                         //
+////////////////////////////////////////////////////////////////////////////
+
+//the instrument adds one file a day, so a run should only parse the new ones
+//every parsed file is kept as its own segment (a column store) in a folder next to the year output,
+//manifest.txt in that folder lists path, size, modification time and content hash of every file
+//together with its segment
+//a file is parsed again only if size or time changed and the content hash is different,
+//all other files are read back from their segments
+//segments are written once and never changed, a changed file gets a new one (append only),
+//segments nobody refers to any more are removed when the manifest is saved
+
+#ifndef INGEST_STORE_H
+#define INGEST_STORE_H
+
+//shared reader for mapping files
+#include "picarro_reader.h"
+
+#include <string> //for using strings
+#include <string_view> //for hashing the mapping
+#include <vector> //for using vectors
+#include <map> //for the manifest
+#include <filesystem> //for file size and time
+#include <fstream> //for the manifest file
+#include <sstream> //for reading the manifest
+#include <chrono> //for modification time
+#include <cstdint> //fixed size types
+#include <cstring> //for memcpy
+#include <cstdio> //for snprintf
+#include <cstdlib> //for strtoull
+
+const std::string manifest_name = "manifest.txt";
+
+//64 bit FNV-1a over 8 byte words, only used to see if a file changed
+inline uint64_t hashContent(std::string_view text)
+{
+    const uint64_t prime = 0x100000001b3ULL;
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    size_t i = 0;
+    for (; i + 8 <= text.size(); i += 8)
+    {
+        uint64_t word;
+        memcpy(&word, text.data() + i, 8);
+        hash = (hash ^ word) * prime;
+    };
+    for (; i < text.size(); i++){hash = (hash ^ static_cast<unsigned char>(text[i])) * prime;};
+    return (hash ^ text.size()) * prime;
+};
+
+inline std::string hashText(uint64_t hash)
+{
+    char buf[17];
+    snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(hash));
+    return buf;
+};
+
+//one processed file
+struct ManifestEntry
+{
+    std::string path;
+    uint64_t size = 0;
+    int64_t mtime = 0; //nanoseconds of the file clock
+    uint64_t hash = 0;
+    std::string segment; //file name inside the store folder
+};
+
+class IngestStore
+{
+public:
+    //settings: everything besides the file content the segments depend on (program version, ID list, ...),
+    //different settings or rebuild drop all segments and every file is parsed again
+    IngestStore(std::string store_dir, std::string settings, bool rebuild = 0)
+    {
+        dir_ = store_dir;
+        settings_ = hashText(hashContent(settings));
+        std::error_code ec;
+        std::filesystem::create_directories(dir_, ec);
+        if (!rebuild){load();};
+    };
+
+    //true if the file has to be parsed, entry gets the state of the file and the name of its new segment
+    //unchanged files give their entry as it is in the manifest
+    bool needsParsing(const std::string &path, ManifestEntry &entry)
+    {
+        entry = ManifestEntry();
+        entry.path = path;
+        std::error_code ec;
+        entry.size = std::filesystem::file_size(path, ec);
+        auto time = std::filesystem::last_write_time(path, ec);
+        entry.mtime = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+
+        auto itr = entries_.find(path);
+        bool known = itr != entries_.end() && std::filesystem::exists(segmentPath(itr->second), ec);
+        if (known && itr->second.size == entry.size && itr->second.mtime == entry.mtime)
+        {
+            entry = itr->second;
+            return 0;
+        };
+        MappedFile file(path);
+        entry.hash = hashContent(file.view());
+        if (known && itr->second.size == entry.size && itr->second.hash == entry.hash)
+        {
+            //only touched, content is the same
+            itr->second.mtime = entry.mtime;
+            entry = itr->second;
+            return 0;
+        };
+        std::string name = std::filesystem::path(path).stem().string();
+        entry.segment = name + "_" + hashText(entry.hash) + ".pcol";
+        return 1;
+    };
+
+    std::string segmentPath(const ManifestEntry &entry) const {return dir_ + "/" + entry.segment;};
+
+    //segment of entry is written, not thread safe
+    void commit(const ManifestEntry &entry){entries_[entry.path] = entry;};
+
+    //files that are no longer in the folder are dropped, so the output is the same as parsing the whole folder
+    void retain(const std::vector<std::string> &paths)
+    {
+        std::map<std::string, ManifestEntry> kept;
+        for (size_t i = 0; i < paths.size(); i++)
+        {
+            auto itr = entries_.find(paths[i]);
+            if (itr != entries_.end()){kept.insert(*itr);};
+        };
+        entries_.swap(kept);
+    };
+
+    //write manifest and remove segments that are not in it
+    bool save()
+    {
+        std::string tmp = dir_ + "/" + manifest_name + ".tmp";
+        {
+            std::ofstream outFile(tmp, std::ios::trunc);
+            if (!outFile.is_open()){return 0;};
+            outFile << "settings\t" << settings_ << "\n";
+            for (auto &item : entries_)
+            {
+                const ManifestEntry &entry = item.second;
+                outFile << hashText(entry.hash) << "\t" << entry.size << "\t" << entry.mtime << "\t" << entry.segment << "\t" << entry.path << "\n";
+            };
+            if (!outFile.good()){return 0;};
+        };
+        std::error_code ec;
+        std::filesystem::rename(tmp, dir_ + "/" + manifest_name, ec);
+        if (ec){return 0;};
+
+        std::map<std::string, bool> used;
+        for (auto &item : entries_){used[item.second.segment] = 1;};
+        for (auto &itr : std::filesystem::directory_iterator(dir_, ec))
+        {
+            std::string name = itr.path().filename().string();
+            if (itr.path().extension() == ".pcol" && !used.count(name)){std::filesystem::remove(itr.path(), ec);};
+        };
+        return 1;
+    };
+
+    size_t size() const {return entries_.size();};
+
+private:
+    void load()
+    {
+        std::ifstream inFile(dir_ + "/" + manifest_name);
+        std::string line;
+        if (!getline(inFile, line) || line != "settings\t" + settings_){return;};
+        while (getline(inFile, line))
+        {
+            std::stringstream stst(line);
+            ManifestEntry entry;
+            std::string hash;
+            if (!getline(stst, hash, '\t')){continue;};
+            stst >> entry.size >> entry.mtime;
+            stst.ignore(1);
+            if (!getline(stst, entry.segment, '\t') || !getline(stst, entry.path)){continue;};
+            entry.hash = strtoull(hash.c_str(), nullptr, 16);
+            entries_[entry.path] = entry;
+        };
+    };
+
+    std::string dir_, settings_;
+    std::map<std::string, ManifestEntry> entries_;
+};
+
+#endif
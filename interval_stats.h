@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////
+// Interval statistics of time series for the Picarro L-2130i tools       //
+// author: Sebastian Stezura // E-Mail: sebastian_stezura@gmx.net         //
+// GitHub: CplusplusB                                                     //
+// version: 1 // date: 17.10.2026                                         //
+////////////////////////////////////////////////////////////////////////////
+
+//count, mean, stdev, min and max of every channel of a series inside [begin, end) of intervals
+//(rain events, months, ...), the intervals are sorted by begin and the series is swept once,
+//every sample is only visited by the intervals that contain it
+//times of series and intervals have to be in the same unit (time code or epoch seconds)
+
+#ifndef INTERVAL_STATS_H
+#define INTERVAL_STATS_H
+
+//streaming mean and spread
+#include "running_stats.h"
+
+#include <vector> //for using vectors
+#include <algorithm> //for sorting
+#include <numeric> //for iota
+#include <limits> //for NaN
+#include <cmath> //for NaN check
+
+//summary of one channel inside one interval, missing values (NaN) are not counted
+struct IntervalStats
+{
+    long count = 0;
+    double sum = 0.;
+    double mean = std::numeric_limits<double>::quiet_NaN();
+    double stdev = std::numeric_limits<double>::quiet_NaN(); //sample standard deviation
+    double min = std::numeric_limits<double>::quiet_NaN();
+    double max = std::numeric_limits<double>::quiet_NaN();
+};
+
+//summary of an accumulator
+inline IntervalStats intervalStats(const RunningStats &acc)
+{
+    IntervalStats s;
+    s.count = acc.count;
+    if (acc.count == 0){return s;};
+    s.sum = acc.sum();
+    s.mean = s.sum / s.count; //like the text output always had it, not the Welford mean
+    s.stdev = acc.stdev();
+    s.min = acc.min;
+    s.max = acc.max;
+    return s;
+};
+
+//stats[interval][channel], intervals in the order they are given
+inline std::vector<std::vector<IntervalStats>> aggregateIntervals(const std::vector<double> &begin, const std::vector<double> &end, const std::vector<double> &times, const std::vector<const std::vector<double>*> &channels)
+{
+    std::vector<std::vector<IntervalStats>> stats(begin.size(), std::vector<IntervalStats>(channels.size()));
+
+    //series in time order, files usually are already
+    std::vector<size_t> row(times.size());
+    std::iota(row.begin(), row.end(), 0);
+    if (!std::is_sorted(times.begin(), times.end()))
+    {
+        std::stable_sort(row.begin(), row.end(), [&times](size_t a, size_t b){return times[a] < times[b];});
+    };
+    std::vector<size_t> order(begin.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&begin](size_t a, size_t b){return begin[a] < begin[b];});
+
+    std::vector<RunningStats> acc(channels.size());
+    size_t first = 0; //first sample not before the begin of the current interval
+    for (size_t e : order)
+    {
+        while (first < row.size() && times[row[first]] < begin[e]){first++;};
+        std::fill(acc.begin(), acc.end(), RunningStats());
+        for (size_t k = first; k < row.size() && times[row[k]] < end[e]; k++)
+        {
+            for (size_t c = 0; c < channels.size(); c++)
+            {
+                double x = (*channels[c])[row[k]];
+                if (!std::isnan(x)){acc[c].add(x);};
+            };
+        };
+        for (size_t c = 0; c < channels.size(); c++){stats[e][c] = intervalStats(acc[c]);};
+    };
+    return stats;
+};
+
+#endif
@@ -0,0 +1,294 @@
+////////////////////////////////////////////////////////////////////////////
+// Levelled background logging for the Picarro L-2130i tools              //
+// author: Sebastian Stezura // E-Mail: sebastian_stezura@gmx.net         //
+// GitHub: CplusplusB                                                     //
+// version: 1 // date: 17.10.2026                                         //
+////////////////////////////////////////////////////////////////////////////
+
+//messages of the loops over rows go through the logger instead of cout:
+//  logger.warn("Time Code: ", time_r);    a line of the level, formatted only if the level is shown
+//  LogTally &slope = logger.tally("rows skipped by slope filter");
+//  slope.add("Slope not in range at ", timer);   counted always, only the first lines are shown
+//the lines are put into a ring without locks (any thread, no flush per line) and written in blocks
+//by a background thread, a full ring makes the caller wait for the writer, no line is dropped
+//logger lines are written whole, but not in order with lines printed by cout directly:
+//logger.flush() waits until everything is written, it is called before the program prints
+//directly again (end of the readers, after the parallel loops)
+//logger.summary() prints the count of every tally ("12345 rows skipped by slope filter")
+//levels: error, warn, info, debug, set with "--log LEVEL" or "--quiet" (warn), see run_options.h
+//a forked worker (render_queue.h) has no background thread, its lines are written right away,
+//logger.suspend() ends the background thread before the fork and logger.resume() starts it again
+
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <string> //for using strings
+#include <sstream> //for formatting the lines
+#include <deque> //for the tallies, references stay valid
+#include <atomic> //for the ring and the counters
+#include <thread> //for the background writer
+#include <mutex> //for waking the writer and the tallies
+#include <condition_variable> //for waking the writer
+#include <chrono> //for the write interval
+#include <iostream> //for Input/Output functions
+#include <cstring> //for memcpy
+#include <cstddef> //for size_t
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h> //for getpid
+#define LOGGER_PID() static_cast<long>(getpid())
+#else
+#define LOGGER_PID() 0L
+#endif
+
+enum LogLevel {log_error, log_warn, log_info, log_debug};
+
+class LogTally;
+
+class Logger
+{
+public:
+    Logger() : owner_(LOGGER_PID())
+    {
+        for (size_t i = 0; i < ring_size; i++){ring_[i].seq.store(i, std::memory_order_relaxed);};
+        resume();
+    };
+    ~Logger()
+    {
+        summary();
+        if (writer_.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock(wake_mutex_);
+                stop_ = 1;
+            };
+            wake_.notify_one();
+            writer_.join();
+        };
+    };
+    Logger(const Logger&) = delete;
+    Logger &operator=(const Logger&) = delete;
+
+    void setLevel(LogLevel level){level_.store(level, std::memory_order_relaxed);};
+    //"error", "warn", "info" or "debug", false if unknown
+    bool setLevel(const std::string &name)
+    {
+        const char *names[4] = {"error", "warn", "info", "debug"};
+        for (int l = 0; l < 4; l++)
+        {
+            if (name == names[l]){setLevel(static_cast<LogLevel>(l)); return 1;};
+        };
+        return 0;
+    };
+    bool enabled(LogLevel level) const {return level <= level_.load(std::memory_order_relaxed);};
+
+    template <class... Args> void error(const Args&... args){write(log_error, args...);};
+    template <class... Args> void warn(const Args&... args){write(log_warn, args...);};
+    template <class... Args> void info(const Args&... args){write(log_info, args...);};
+    template <class... Args> void debug(const Args&... args){write(log_debug, args...);};
+
+    template <class... Args> void write(LogLevel level, const Args&... args)
+    {
+        if (!enabled(level)){return;};
+        std::ostringstream line;
+        line << prefix(level);
+        (line << ... << args);
+        push(line.str());
+    };
+
+    //aggregated warning, the same what gives the same tally
+    LogTally &tally(const std::string &what, long shown = 5);
+
+    //waits until all lines so far are written
+    void flush()
+    {
+        size_t target = head_.load(std::memory_order_acquire);
+        while (written_.load(std::memory_order_acquire) < target && running_.load(std::memory_order_acquire) && LOGGER_PID() == owner_)
+        {
+            wake_.notify_one();
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        };
+        std::cout.flush();
+    };
+
+    //count of every tally and waits until it is written, the counts start again at 0
+    void summary();
+
+    //writes everything and ends the background thread, lines are written right away until resume()
+    //only while no other thread logs, e.g. before a fork (render_queue.h)
+    void suspend()
+    {
+        if (!writer_.joinable() || LOGGER_PID() != owner_){return;};
+        running_.store(0, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            stop_ = 1;
+        };
+        wake_.notify_one();
+        writer_.join();
+        std::cout.flush();
+    };
+    //starts the background thread again
+    void resume()
+    {
+        if (writer_.joinable() || LOGGER_PID() != owner_){return;};
+        stop_ = 0;
+        writer_ = std::thread(&Logger::run, this);
+        running_.store(1, std::memory_order_release);
+    };
+
+private:
+    static const size_t ring_size = 4096; //power of 2
+    static const size_t slot_text = 248;
+    struct Slot
+    {
+        std::atomic<size_t> seq;
+        unsigned short size = 0;
+        char text[slot_text];
+    };
+
+    static const char *prefix(LogLevel level)
+    {
+        if (level == log_error){return "Error: ";};
+        if (level == log_warn){return "Warning: ";};
+        if (level == log_debug){return "Debug: ";};
+        return "";
+    };
+
+    //bounded multi producer ring (Vyukov), a slot is free when seq == position
+    //blocks while the ring is full until the writer has taken lines
+    void push(const std::string &text)
+    {
+        if (LOGGER_PID() != owner_ || !running_.load(std::memory_order_acquire))
+        {
+            std::cout << text << '\n';
+            return;
+        };
+        size_t pos = head_.load(std::memory_order_relaxed);
+        Slot *slot;
+        for (;;)
+        {
+            slot = &ring_[pos & (ring_size - 1)];
+            size_t seq = slot->seq.load(std::memory_order_acquire);
+            if (seq == pos)
+            {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){break;};
+            }
+            else if (seq < pos)
+            {
+                //full, the writer is behind
+                wake_.notify_one();
+                std::this_thread::yield();
+                pos = head_.load(std::memory_order_relaxed);
+            }
+            else {pos = head_.load(std::memory_order_relaxed);};
+        };
+        size_t n = text.size() < slot_text ? text.size() : slot_text;
+        std::memcpy(slot->text, text.data(), n);
+        if (n < text.size()){std::memcpy(slot->text + n - 3, "...", 3);};
+        slot->size = static_cast<unsigned short>(n);
+        slot->seq.store(pos + 1, std::memory_order_release);
+        if ((pos & (ring_size/2 - 1)) == 0){wake_.notify_one();};
+    };
+
+    //background writer, lines are written in blocks
+    void run()
+    {
+        std::string block;
+        size_t tail = written_.load(std::memory_order_acquire);
+        for (;;)
+        {
+            bool stop;
+            {
+                std::unique_lock<std::mutex> lock(wake_mutex_);
+                wake_.wait_for(lock, std::chrono::milliseconds(20));
+                stop = stop_;
+            };
+            for (;;)
+            {
+                Slot &slot = ring_[tail & (ring_size - 1)];
+                if (slot.seq.load(std::memory_order_acquire) != tail + 1){break;};
+                block.append(slot.text, slot.size);
+                block += '\n';
+                slot.seq.store(tail + ring_size, std::memory_order_release);
+                tail++;
+            };
+            if (!block.empty())
+            {
+                std::cout.write(block.data(), block.size());
+                std::cout.flush();
+                block.clear();
+            };
+            written_.store(tail, std::memory_order_release);
+            if (stop && tail == head_.load(std::memory_order_acquire)){return;};
+        };
+    };
+
+    long owner_; //process of the writer
+    std::atomic<int> level_{log_info};
+    Slot ring_[ring_size];
+    std::atomic<size_t> head_{0}; //next position to write to
+    std::atomic<size_t> written_{0}; //positions written by the writer
+    std::thread writer_;
+    std::atomic<bool> running_{0}; //background thread takes the lines
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    bool stop_ = 0;
+    std::mutex tally_mutex_;
+    std::deque<LogTally> tallies_;
+};
+
+//one kind of warning of a loop, e.g. rows rejected by a filter
+class LogTally
+{
+public:
+    LogTally(Logger &logger, const std::string &what, long shown) : logger_(logger), what_(what), shown_(shown){};
+
+    //counts the row and shows the line for the first ones
+    template <class... Args> void add(const Args&... args)
+    {
+        long n = count_.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (n <= shown_){logger_.warn(args...);};
+    };
+    long count() const {return count_.load(std::memory_order_relaxed);};
+    const std::string &what() const {return what_;};
+    long shown() const {return shown_;};
+    long reset(){return count_.exchange(0, std::memory_order_relaxed);};
+
+private:
+    Logger &logger_;
+    std::string what_;
+    long shown_;
+    std::atomic<long> count_{0};
+};
+
+inline LogTally &Logger::tally(const std::string &what, long shown)
+{
+    std::lock_guard<std::mutex> lock(tally_mutex_);
+    for (LogTally &t : tallies_)
+    {
+        if (t.what() == what){return t;};
+    };
+    tallies_.emplace_back(*this, what, shown);
+    return tallies_.back();
+};
+
+inline void Logger::summary()
+{
+    {
+        std::lock_guard<std::mutex> lock(tally_mutex_);
+        for (LogTally &t : tallies_)
+        {
+            long n = t.reset();
+            if (n == 0){continue;};
+            if (n > t.shown()){warn(n, " ", t.what(), " (first ", t.shown(), " shown)");}
+            else {info(n, " ", t.what());};
+        };
+    };
+    flush();
+};
+
+//one logger per program
+inline Logger logger;
+
+#endif
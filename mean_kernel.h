@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////////////////////
+// Window means of three channels for the Picarro L-2130i tools           //
+// author: Sebastian Stezura // E-Mail: sebastian_stezura@gmx.net         //
+// GitHub: CplusplusB                                                     //
+// version: 1 // date: 17.10.2026                                         //
+////////////////////////////////////////////////////////////////////////////
+
+//means of H2O, H2 and O18 over windows of width samples, the three channels in one loop
+//  mean_block     windows [k*width, (k+1)*width), an incomplete last block is dropped (meanXminData)
+//  mean_sliding   windows [k, k+width), one mean per sample as long as the window is full
+//a window is summed in 4 lanes with SIMD (GCC/Clang vector extension, plain arrays otherwise),
+//lanes are added in a fixed order so both ways and the streaming evaluation give the same bits
+//the output arrays are allocated by the caller with meanCount() entries
+
+#ifndef MEAN_KERNEL_H
+#define MEAN_KERNEL_H
+
+#include <cstddef> //for size_t
+#include <cstring> //for memcpy
+
+enum MeanMode
+{
+    mean_block,
+    mean_sliding
+};
+
+//number of means of n samples
+inline size_t meanCount(size_t n, size_t width, MeanMode mode)
+{
+    if (width == 0 || n < width){return 0;};
+    return mode == mean_block ? n / width : n - width + 1;
+};
+
+//first sample of window k
+inline size_t windowBegin(size_t k, size_t width, MeanMode mode)
+{
+    return mode == mean_block ? k * width : k;
+};
+
+//sums of n samples of three channels
+inline void windowSum3(const double *a, const double *b, const double *c, size_t n, double &sum_a, double &sum_b, double &sum_c)
+{
+    size_t i = 0;
+#if defined(__GNUC__)
+    typedef double lanes __attribute__((vector_size(32)));
+    lanes va = {0., 0., 0., 0.}, vb = va, vc = va;
+    for (; i + 4 <= n; i += 4)
+    {
+        lanes xa, xb, xc;
+        memcpy(&xa, a + i, sizeof(lanes));
+        memcpy(&xb, b + i, sizeof(lanes));
+        memcpy(&xc, c + i, sizeof(lanes));
+        va += xa;
+        vb += xb;
+        vc += xc;
+    };
+    sum_a = (va[0] + va[1]) + (va[2] + va[3]);
+    sum_b = (vb[0] + vb[1]) + (vb[2] + vb[3]);
+    sum_c = (vc[0] + vc[1]) + (vc[2] + vc[3]);
+#else
+    double va[4] = {0., 0., 0., 0.}, vb[4] = {0., 0., 0., 0.}, vc[4] = {0., 0., 0., 0.};
+    for (; i + 4 <= n; i += 4)
+    {
+        for (int l = 0; l < 4; l++)
+        {
+            va[l] += a[i+l];
+            vb[l] += b[i+l];
+            vc[l] += c[i+l];
+        };
+    };
+    sum_a = (va[0] + va[1]) + (va[2] + va[3]);
+    sum_b = (vb[0] + vb[1]) + (vb[2] + vb[3]);
+    sum_c = (vc[0] + vc[1]) + (vc[2] + vc[3]);
+#endif
+    for (; i < n; i++)
+    {
+        sum_a += a[i];
+        sum_b += b[i];
+        sum_c += c[i];
+    };
+};
+
+//means of all windows, out_* need meanCount(n, width, mode) entries
+//sliding windows move the sums by one sample and are summed fresh every width means,
+//so rounding can not pile up over a year
+inline size_t windowMean3(const double *a, const double *b, const double *c, size_t n, size_t width, MeanMode mode, double *out_a, double *out_b, double *out_c)
+{
+    size_t count = meanCount(n, width, mode);
+    double sum_a = 0., sum_b = 0., sum_c = 0.;
+    for (size_t k = 0; k < count; k++)
+    {
+        size_t begin = windowBegin(k, width, mode);
+        if (mode == mean_block || k % width == 0){windowSum3(a + begin, b + begin, c + begin, width, sum_a, sum_b, sum_c);}
+        else
+        {
+            size_t end = begin + width - 1;
+            sum_a += a[end] - a[begin-1];
+            sum_b += b[end] - b[begin-1];
+            sum_c += c[end] - c[begin-1];
+            //a missing value (NaN) left the window
+            if (sum_a != sum_a || sum_b != sum_b || sum_c != sum_c){windowSum3(a + begin, b + begin, c + begin, width, sum_a, sum_b, sum_c);};
+        };
+        out_a[k] = sum_a / width;
+        out_b[k] = sum_b / width;
+        out_c[k] = sum_c / width;
+    };
+    return count;
+};
+
+#endif
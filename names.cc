@@ -6,6 +6,7 @@
 ////////////////////////////////////////////////////////////////////////////
 
 // Get ID names in .csv Files in Folder. Write ID names in Standards_eval_names_YEAR_CURR_TIME.txt
+// "./GetNames.o --input DIR --output DIR --batch" runs without dialogs, see run_options.h
 
 ////////////////////////////////////////////////////////////////////////////
 // compile command:                                                       //
@@ -22,6 +23,15 @@
 //////////////////////////////////////////////////////////////////////////////////
 #include "tinyfiledialogs.h"
 
+//shared reader for Picarro csv files
+#include "picarro_reader.h"
+//dictionary of identifiers
+#include "data_columns.h"
+//command line and config file options
+#include "run_options.h"
+//stage times and counters
+#include "stage_report.h"
+
 ////////////////////
 // C/C++ includes //
 ////////////////////
@@ -31,6 +41,7 @@
 #include <filesystem> //using c++-17 filesystem
 #include <fstream> //for reading and writing to files
 #include <sstream> //for reading files
+#include <string_view> //for fields of the mapped files
 #include <algorithm> //for different C/C++ functions
 #include <ctime>  //for time
 
@@ -39,9 +50,8 @@ namespace fs = std::filesystem;
 
 
 //getting files for evaluation
-void getFiles(vector<string> &names, vector<string> &dates, vector<string> &adresses)
+void getFiles(string afilepath, vector<string> &names, vector<string> &dates, vector<string> &adresses)
 {
-    string afilepath = tinyfd_selectFolderDialog("Choose Folder with csv Files", ".");
 
     string filesubstr;
     fs::path pafilepath(afilepath);
@@ -71,90 +81,47 @@ void getFiles(vector<string> &names, vector<string> &dates, vector<string> &adre
 };
 
 //check identifier
-bool checkID_same(vector<string> identifier, string data_ID)
+bool checkID_same(const Dictionary &identifier, string_view data_ID)
 {
-    bool ID_same = 0;
-    for (int i = 0; i < identifier.size(); i++)
-    {
-        if (identifier[i] == data_ID){ID_same = 1;};
-    };
-    return ID_same;
+    return identifier.contains(data_ID);
 };
 
 //getting Data from files
-void getNames(string name, string files_adress, vector<string> &unique_ID)
+void getNames(string name, string files_adress, Dictionary &unique_ID)
 {
-    string line_r, analysis_r, time_code_r, port_r, inj_nmb_r, O18w_r, H2w_r, H2Ow_mean_r, ignore_r, good_r, O18v_r, H2v_r, H2Ov_mean_r, identifier1_r, identifier2_r, gas_conf_r, time_mean_r, O18_sd_r, H2_sd_r, H2O_sd_r, O18_sl_r, H2_sl_r, H2O_sl_r, base_shift_r, slope_r, res_r, base_curv_r, interval_r, CH4_r, H2O_adj_r, H2O_shift_r, n2_r, temp_r, tray_r, sample_r, job_r, method_r, error_r;
-    //loop over alle files
-    ifstream inFile (files_adress);
+    string_view field[picarro_columns];
+    string identifier_buf;
+    //map file, lines and fields are views into the mapping
+    MappedFile inFile (files_adress);
     cout << "Reading file " << name << " ..." << endl;
     // read signal values from file
-	if (inFile.is_open())
+	if (inFile.isOpen())
 	{
         int i = 0;
-        string line;
-        while (getline(inFile, line))
+        long n_rows = 0;
+        string_view text = inFile.view();
+        string_view line;
+        while (nextLine(text, line))
 		{
-            remove(line.begin(), line.end(), ' ');
-            stringstream stst(line);
-            getline(stst,line_r,',');
-            getline(stst,analysis_r,',');
-            getline(stst,time_code_r,',');
-            getline(stst,port_r,',');
-            getline(stst,inj_nmb_r,',');
-            getline(stst,O18w_r,',');
-            getline(stst,H2w_r,',');
-            getline(stst,H2Ow_mean_r,',');
-            getline(stst,ignore_r,',');
-            getline(stst,good_r,',');
-            getline(stst,O18v_r,',');
-            getline(stst,H2v_r,',');
-            getline(stst,H2Ov_mean_r,',');
-            getline(stst,identifier1_r,',');
-            getline(stst,identifier2_r,',');
-            getline(stst,gas_conf_r,',');
-            getline(stst,time_mean_r,',');
-            getline(stst,O18_sd_r,',');
-            getline(stst,H2_sd_r,',');
-            getline(stst,H2O_sd_r,',');
-            getline(stst,O18_sl_r,',');
-            getline(stst,H2_sl_r,',');
-            getline(stst,H2O_sl_r,',');
-            getline(stst,base_shift_r,',');
-            getline(stst,slope_r,',');
-            getline(stst,res_r,',');
-            getline(stst,base_curv_r,',');
-            getline(stst,interval_r,',');
-            getline(stst,CH4_r,',');
-            getline(stst,H2O_adj_r,',');
-            getline(stst,H2O_shift_r,',');
-            getline(stst,n2_r,',');
-            getline(stst,temp_r,',');
-            getline(stst,tray_r,',');
-            getline(stst,sample_r,',');
-            getline(stst,job_r,',');
-            getline(stst,method_r,',');
-            getline(stst,error_r,',');
-
-            //format time format
-            remove(time_code_r.begin(), time_code_r.end(), '/');
-            remove(time_code_r.begin(), time_code_r.end(), ':');
-            for (int j = 0; j < 4; j++) {if (!time_code_r.empty()) {time_code_r.pop_back();};};
-
             if (i == 0) {i = 1; continue;};
+            n_rows++;
+            splitFields(line, ',', field, picarro_columns);
+            string_view identifier2_r = stripSpaces(field[col_identifier2], identifier_buf);
+
             if (!checkID_same(unique_ID, identifier2_r) && identifier2_r != "")
             {
-                unique_ID.push_back(identifier2_r);
+                unique_ID.add(identifier2_r);
                 cout << identifier2_r << endl;
             };
 		};
+        stage_report.count("read", "rows read", n_rows);
 	};
     inFile.close();
 
 };
 
 //write evaluated Data
-void writeData(string year, string evalpath, vector<string> unique_ID)
+void writeData(string year, string evalpath, const Dictionary &unique_ID)
 {
     time_t t = time(0);
     string c_time = ctime(&t);
@@ -172,6 +139,10 @@ void writeData(string year, string evalpath, vector<string> unique_ID)
 
 int main(int argc, char* argv[])
 {
+    RunOptions options(argc, argv,
+        "  --input DIR        folder with csv files\n"
+        "  --output DIR       folder for evaluation\n");
+
     //////////////////////////////////
     // Name, date and path to files //
     //////////////////////////////////
@@ -179,10 +150,15 @@ int main(int argc, char* argv[])
     vector<string> files_date;
     vector<string> files_adress;
     string year;
+    stage_report.setProgram("names");
 
-    getFiles(files_name, files_date, files_adress);
+    {
+        auto timer = stage_report.time("catalog");
+        getFiles(options.selectFolder("input", "Choose Folder with csv Files"), files_name, files_date, files_adress);
+        stage_report.count("catalog", "files", files_name.size());
+    };
     //choose directory for evaluation data
-    string evalpath = tinyfd_selectFolderDialog("Choose Folder for Evaluation", ".");
+    string evalpath = options.selectFolder("output", "Choose Folder for Evaluation");
     cout << "Evalpath " << evalpath << endl;
     year = files_date[0].substr(0,4);
     //cout << year << endl; //debug
@@ -190,15 +166,23 @@ int main(int argc, char* argv[])
     //////////////////////////////////////////////////
     // Read csv file(s) and store values in vectors //
     //////////////////////////////////////////////////
-    vector<string> unique_ID;
+    Dictionary unique_ID;
+    auto read_timer = stage_report.time("read");
     for (int i = 0; i < files_name.size(); i++)
     {
         cout << files_name[i] << " at " << files_adress[i] << endl;
         getNames(files_name[i], files_adress[i], unique_ID);
     };
+    read_timer.stop();
+    stage_report.count("read", "identifiers", unique_ID.size());
 
     //write to file
-    writeData(year, evalpath, unique_ID);
+    {
+        auto timer = stage_report.time("write");
+        writeData(year, evalpath, unique_ID);
+    };
+    logger.summary();
+    stage_report.write(options.get("report", evalpath + "/Standards_names_" + year + "_report"));
 
 
 
@@ -0,0 +1,262 @@
+////////////////////////////////////////////////////////////////////////////
+// Shared reader for csv exports of the Picarro L-2130i                   //
+// author: Sebastian Stezura // E-Mail: sebastian_stezura@gmx.net         //
+// GitHub: CplusplusB                                                     //
+// version: 1 // date: 17.10.2026                                         //
+////////////////////////////////////////////////////////////////////////////
+
+//memory maps a file and hands out lines and fields as string_view into the mapping
+//nothing is copied, the views are valid as long as the MappedFile is open
+//header only, just include it next to tinyfiledialogs.h
+
+#ifndef PICARRO_READER_H
+#define PICARRO_READER_H
+
+#include <string> //for using strings
+#include <string_view> //for views into the mapping
+#include <vector> //for splitting into chunks
+#include <fstream> //fallback if mapping is not possible
+#include <sstream> //fallback if mapping is not possible
+#include <cstdlib> //for strtod
+#include <cstring> //for memcpy
+#include <cmath> //for missing time codes
+
+#ifndef _WIN32
+#include <fcntl.h> //open
+#include <unistd.h> //close
+#include <sys/mman.h> //mmap
+#include <sys/stat.h> //fstat
+#endif
+
+//columns of a Picarro L-2130i export, same order as the header line
+enum PicarroColumn
+{
+    col_line, col_analysis, col_time_code, col_port, col_inj_nmb, col_O18w, col_H2w, col_H2Ow_mean, col_ignore, col_good,
+    col_O18v, col_H2v, col_H2Ov_mean, col_identifier1, col_identifier2, col_gas_conf, col_time_mean, col_O18_sd, col_H2_sd, col_H2O_sd,
+    col_O18_sl, col_H2_sl, col_H2O_sl, col_base_shift, col_slope, col_res, col_base_curv, col_interval, col_CH4, col_H2O_adj,
+    col_H2O_shift, col_n2, col_temp, col_tray, col_sample, col_job, col_method, col_error,
+    picarro_columns
+};
+
+//read only view on a whole file
+class MappedFile
+{
+public:
+    MappedFile(){};
+    MappedFile(const std::string &path){open(path);};
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    ~MappedFile(){close();};
+
+    //map file, falls back to reading it into memory if mmap is not available
+    bool open(const std::string &path)
+    {
+        close();
+#ifndef _WIN32
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0){return 0;};
+        struct stat st{};
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED)
+            {
+                madvise(addr, st.st_size, MADV_SEQUENTIAL);
+                data_ = static_cast<const char*>(addr);
+                size_ = st.st_size;
+                mapped_ = 1;
+            };
+        };
+        ::close(fd);
+        if (mapped_ || st.st_size == 0){is_open_ = 1; return 1;};
+#endif
+        readFallback(path);
+        return is_open_;
+    };
+
+    void close()
+    {
+#ifndef _WIN32
+        if (mapped_){munmap(const_cast<char*>(data_), size_);};
+#endif
+        data_ = nullptr;
+        size_ = 0;
+        mapped_ = 0;
+        is_open_ = 0;
+        buffer_.clear();
+    };
+
+    bool isOpen() const {return is_open_;};
+    size_t size() const {return size_;};
+    std::string_view view() const {return std::string_view(data_, size_);};
+
+private:
+    void readFallback(const std::string &path)
+    {
+        std::ifstream inFile(path, std::ios::binary);
+        if (!inFile.is_open()){return;};
+        std::stringstream content;
+        content << inFile.rdbuf();
+        buffer_ = content.str();
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+        is_open_ = 1;
+    };
+
+    const char *data_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = 0;
+    bool is_open_ = 0;
+    std::string buffer_;
+};
+
+//take next line from text, strips '\r' of windows line endings
+inline bool nextLine(std::string_view &text, std::string_view &line)
+{
+    if (text.empty()){return 0;};
+    size_t end = text.find('\n');
+    if (end == std::string_view::npos)
+    {
+        line = text;
+        text = std::string_view();
+    }
+    else
+    {
+        line = text.substr(0, end);
+        text.remove_prefix(end+1);
+    };
+    if (!line.empty() && line.back() == '\r'){line.remove_suffix(1);};
+    return 1;
+};
+
+//split text into parts of about chunk_size bytes, every part ends after a '\n'
+//lines are never cut, so the parts can be read independently with nextLine
+inline std::vector<std::string_view> splitChunks(std::string_view text, size_t chunk_size)
+{
+    std::vector<std::string_view> chunks;
+    if (chunk_size == 0){chunk_size = 1;};
+    while (!text.empty())
+    {
+        size_t end = text.size();
+        if (chunk_size < text.size())
+        {
+            end = text.find('\n', chunk_size-1);
+            end = end == std::string_view::npos ? text.size() : end+1;
+        };
+        chunks.push_back(text.substr(0, end));
+        text.remove_prefix(end);
+    };
+    return chunks;
+};
+
+//remove leading and trailing spaces
+inline std::string_view trimField(std::string_view field)
+{
+    while (!field.empty() && (field.front() == ' ' || field.front() == '\t')){field.remove_prefix(1);};
+    while (!field.empty() && (field.back() == ' ' || field.back() == '\t')){field.remove_suffix(1);};
+    return field;
+};
+
+//split line at separator into trimmed fields, missing fields are left empty
+//returns number of fields found in line
+inline int splitFields(std::string_view line, char sep, std::string_view *fields, int max_fields)
+{
+    int n = 0;
+    size_t start = 0;
+    while (n < max_fields)
+    {
+        size_t end = line.find(sep, start);
+        if (end == std::string_view::npos)
+        {
+            fields[n++] = trimField(line.substr(start));
+            break;
+        };
+        fields[n++] = trimField(line.substr(start, end-start));
+        start = end+1;
+    };
+    for (int i = n; i < max_fields; i++){fields[i] = std::string_view();};
+    return n;
+};
+
+//same as removing all spaces of a field, only copies into buf if there are spaces inside
+inline std::string_view stripSpaces(std::string_view field, std::string &buf)
+{
+    if (field.find(' ') == std::string_view::npos){return field;};
+    buf.clear();
+    for (char c : field){if (c != ' '){buf.push_back(c);};};
+    return buf;
+};
+
+//parse number without allocating, returns 0 if field is empty or not a number
+inline bool parseDouble(std::string_view field, double &value)
+{
+    char buf[64];
+    if (field.empty() || field.size() >= sizeof(buf)){return 0;};
+    memcpy(buf, field.data(), field.size());
+    buf[field.size()] = '\0';
+    char *end;
+    value = strtod(buf, &end);
+    return end != buf;
+};
+
+inline bool parseInt(std::string_view field, int &value)
+{
+    double d;
+    if (!parseDouble(field, d)){return 0;};
+    value = static_cast<int>(d);
+    return 1;
+};
+
+//Picarro time "YYYY/MM/DD HH:MM:SS.sss" to time code "YYYYMMDDHHMMSS.sss" as used in all output files
+inline void formatTimeCode(std::string_view time_field, std::string &time_code)
+{
+    time_code.clear();
+    for (char c : time_field)
+    {
+        if ((c >= '0' && c <= '9') || c == '.'){time_code.push_back(c);};
+    };
+};
+
+//memory correction of ambient air: the first 180 Ambient rows after a H2O standard are dropped
+//feed every row of a file in order, a new filter for every file
+class MemoryFilter
+{
+public:
+    //true if the row is Ambient and kept
+    bool keep(bool ambient, bool H2O)
+    {
+        if (ambient && last_H2O_)
+        {
+            memory_++;
+            if (memory_ <= 180){return 0;};
+        };
+        if (memory_ >= 180){memory_ = 0;};
+        last_H2O_ = H2O;
+        return ambient;
+    };
+
+private:
+    bool last_H2O_ = 0;
+    int memory_ = 0;
+};
+
+//numeric time code YYYYMMDDHHMMSS.sss back into its parts, fractions of seconds are dropped
+//false and all parts 0 for a missing time code (NaN, written by ambient.cc for unreadable times)
+inline bool splitTimeCode(double time_code, int &year, int &month, int &day, int &hour, int &min, int &sec)
+{
+    if (!std::isfinite(time_code) || time_code < 0.)
+    {
+        year = month = day = hour = min = sec = 0;
+        return 0;
+    };
+    long long code = static_cast<long long>(time_code);
+    sec = code % 100; code /= 100;
+    min = code % 100; code /= 100;
+    hour = code % 100; code /= 100;
+    day = code % 100; code /= 100;
+    month = code % 100; code /= 100;
+    year = code;
+    return 1;
+};
+
+#endif
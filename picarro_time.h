@@ -0,0 +1,179 @@
+////////////////////////////////////////////////////////////////////////////
+// Timestamp decoder for the Picarro L-2130i tools                        //
+// author: Sebastian Stezura // E-Mail: sebastian_stezura@gmx.net         //
+// GitHub: CplusplusB                                                     //
+// version: 1 // date: 17.10.2026                                         //
+////////////////////////////////////////////////////////////////////////////
+
+//decodes the fixed time layouts of all input files without creating strings:
+//  Picarro csv       "YYYY/MM/DD HH:MM:SS.sss"
+//  meteo .dat        "YYYY-MM-DD HH:MM:SS" (also with the space removed)
+//  time code         "YYYYMMDDHHMMSS.sss" as written by the programs
+//the 14 digits are collected into two 8 byte words and converted at once (SWAR),
+//every byte is checked to be a digit in the same step
+//epoch seconds are counted as UTC from the clock time of the file
+
+#ifndef PICARRO_TIME_H
+#define PICARRO_TIME_H
+
+#include <string_view> //for fields of the mapped files
+#include <cstdint> //fixed size types
+#include <cstring> //for memcpy
+#include <cstdlib> //for strtod
+
+//one decoded timestamp
+struct TimeStamp
+{
+    int year = 0, month = 0, day = 0, hour = 0, min = 0, sec = 0;
+    double frac = 0.; //fraction of second
+    int64_t epoch = 0; //seconds since 1970-01-01 00:00:00
+    double time_code = 0.; //YYYYMMDDHHMMSS.sss as number
+};
+
+//days since 1970-01-01 of a date (proleptic gregorian calendar)
+inline int64_t daysFromCivil(int year, int month, int day)
+{
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year-399) / 400;
+    const int64_t yoe = year - era * 400;
+    const int64_t doy = (153*(month + (month > 2 ? -3 : 9)) + 2)/5 + day-1;
+    const int64_t doe = yoe * 365 + yoe/4 - yoe/100 + doy;
+    return era * 146097 + doe - 719468;
+};
+
+inline int64_t epochFromParts(int year, int month, int day, int hour, int min, int sec)
+{
+    return daysFromCivil(year, month, day)*86400 + hour*3600 + min*60 + sec;
+};
+
+//date and clock time of epoch seconds, inverse of epochFromParts
+inline void civilFromEpoch(int64_t t, int &year, int &month, int &day, int &hour, int &min, int &sec)
+{
+    int64_t days = t >= 0 ? t/86400 : (t - 86399)/86400;
+    int64_t sec_day = t - days*86400;
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days-146096) / 146097;
+    const int64_t doe = days - era*146097;
+    const int64_t yoe = (doe - doe/1460 + doe/36524 - doe/146096)/365;
+    const int64_t doy = doe - (365*yoe + yoe/4 - yoe/100);
+    const int64_t mp = (5*doy + 2)/153;
+    day = doy - (153*mp + 2)/5 + 1;
+    month = mp < 10 ? mp+3 : mp-9;
+    year = yoe + era*400 + (month <= 2);
+    hour = sec_day/3600;
+    min = sec_day/60%60;
+    sec = sec_day%60;
+};
+
+//time code YYYYMMDDHHMMSS of epoch seconds
+inline double timeCodeFromEpoch(int64_t t)
+{
+    int year, month, day, hour, min, sec;
+    civilFromEpoch(t, year, month, day, hour, min, sec);
+    return ((((year*100. + month)*100. + day)*100. + hour)*100. + min)*100. + sec;
+};
+
+//8 ascii digits to four 2-digit numbers, false if one byte is not a digit
+//byte i of the word is character i (little endian), lane k holds digits 2k and 2k+1
+inline bool swarDigitPairs(const char *digits, uint64_t &pairs)
+{
+    uint64_t word;
+    memcpy(&word, digits, 8);
+    //high nibble of every byte must be 3 before and after adding 6 ('0'..'9' only)
+    if (((word & 0xF0F0F0F0F0F0F0F0ULL) | (((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) != 0x3333333333333333ULL){return 0;};
+    word -= 0x3030303030303030ULL;
+    pairs = ((word * 10) + (word >> 8)) & 0x00FF00FF00FF00FFULL;
+    return 1;
+};
+
+inline int pairLane(uint64_t pairs, int lane){return static_cast<int>((pairs >> (16*lane)) & 0xFF);};
+
+//digits after the decimal point, fraction of the whole
+inline bool decodeFraction(std::string_view field, double &frac)
+{
+    frac = 0.;
+    if (field.empty()){return 1;};
+    if (field[0] != '.'){return 0;};
+    int value = 0;
+    size_t n = field.size() - 1;
+    for (size_t i = 1; i < field.size(); i++)
+    {
+        if (field[i] < '0' || field[i] > '9'){return 0;};
+        if (i <= 3){value = value*10 + (field[i]-'0');};
+    };
+    if (n <= 3)
+    {
+        static const double scale[4] = {1., 10., 100., 1000.};
+        frac = value / scale[n];
+    }
+    else
+    {
+        //more digits than milliseconds are rare, let strtod round them
+        char buf[32];
+        if (field.size() >= sizeof(buf)){return 0;};
+        buf[0] = '0';
+        memcpy(buf + 1, field.data(), field.size());
+        buf[field.size() + 1] = '\0';
+        frac = strtod(buf, nullptr);
+    };
+    return 1;
+};
+
+//ranges, conversion to epoch and time code from the digit words
+inline bool finishTimeStamp(uint64_t date_pairs, uint64_t clock_pairs, std::string_view frac_field, TimeStamp &ts)
+{
+    ts.year = pairLane(date_pairs, 0)*100 + pairLane(date_pairs, 1);
+    ts.month = pairLane(date_pairs, 2);
+    ts.day = pairLane(date_pairs, 3);
+    ts.hour = pairLane(clock_pairs, 0);
+    ts.min = pairLane(clock_pairs, 1);
+    ts.sec = pairLane(clock_pairs, 2);
+    if (ts.month < 1 || ts.month > 12 || ts.day < 1 || ts.day > 31 || ts.hour > 23 || ts.min > 59 || ts.sec > 60){return 0;};
+    if (!decodeFraction(frac_field, ts.frac)){return 0;};
+    ts.epoch = epochFromParts(ts.year, ts.month, ts.day, ts.hour, ts.min, ts.sec);
+    //integer part is exact in a double, adding the fraction rounds like strtod of the text
+    int64_t code = ((((static_cast<int64_t>(ts.year)*100 + ts.month)*100 + ts.day)*100 + ts.hour)*100 + ts.min)*100 + ts.sec;
+    ts.time_code = static_cast<double>(code) + ts.frac;
+    return 1;
+};
+
+//"YYYY/MM/DD HH:MM:SS.sss" or "YYYY-MM-DD HH:MM:SS", date and time may also be joined without space
+inline bool decodeTimestamp(std::string_view field, TimeStamp &ts)
+{
+    //position of the clock after the date
+    if (field.size() < 18){return 0;};
+    size_t clock = (field[10] >= '0' && field[10] <= '9') ? 10 : 11;
+    if (field.size() < clock+8){return 0;};
+    char sep = field[4];
+    if ((sep != '/' && sep != '-') || field[7] != sep || field[clock+2] != ':' || field[clock+5] != ':'){return 0;};
+    if (clock == 11 && field[10] != ' ' && field[10] != 'T'){return 0;};
+
+    //gather digits into two words: YYYYMMDD and HHMMSS00
+    char digits[16];
+    memcpy(digits, field.data(), 4);
+    memcpy(digits + 4, field.data() + 5, 2);
+    memcpy(digits + 6, field.data() + 8, 2);
+    memcpy(digits + 8, field.data() + clock, 2);
+    memcpy(digits + 10, field.data() + clock + 3, 2);
+    memcpy(digits + 12, field.data() + clock + 6, 2);
+    digits[14] = '0';
+    digits[15] = '0';
+    uint64_t date_pairs, clock_pairs;
+    if (!swarDigitPairs(digits, date_pairs) || !swarDigitPairs(digits + 8, clock_pairs)){return 0;};
+    return finishTimeStamp(date_pairs, clock_pairs, field.substr(clock+8), ts);
+};
+
+//time code "YYYYMMDDHHMMSS.sss" of the output files
+inline bool decodeTimeCode(std::string_view field, TimeStamp &ts)
+{
+    if (field.size() < 14){return 0;};
+    char digits[16];
+    memcpy(digits, field.data(), 14);
+    digits[14] = '0';
+    digits[15] = '0';
+    uint64_t date_pairs, clock_pairs;
+    if (!swarDigitPairs(digits, date_pairs) || !swarDigitPairs(digits + 8, clock_pairs)){return 0;};
+    return finishTimeStamp(date_pairs, clock_pairs, field.substr(14), ts);
+};
+
+#endif
@@ -8,6 +8,8 @@
 //read .csv files from month, event based rainsamples and flask
 //read meteo data and correlated them to the rain samples
 //plot some Graphs
+//the years are taken from the samples and the meteo files may cover any years, every year found gets its graphs
+//"--event FILE --month FILE --flask FILE --meteo FILE,FILE,... --output DIR --batch" runs without dialogs, see run_options.h
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // compile command:                                                                                                          //
@@ -24,6 +26,21 @@
 //////////////////////////////////////////////////////////////////////////////////
 #include "tinyfiledialogs.h"
 
+//timestamp decoder
+#include "picarro_time.h"
+//statistics of meteo data inside rain events
+#include "interval_stats.h"
+//command line and config file options
+#include "run_options.h"
+//drawing in worker processes
+#include "render_queue.h"
+//rows of the years
+#include "year_range.h"
+//stage times and counters
+#include "stage_report.h"
+//warnings of the loops over rows
+#include "logger.h"
+
 ////////////////////
 // C/C++ includes //
 ////////////////////
@@ -38,6 +55,8 @@
 #include <execution> //for parallel stuff
 #include <pthread.h> //multithreading
 #include <thread> //multithreading
+#include <map> //for the years
+#include <cstdlib> //for atoi
 
 /////////////////////////////
 // Root includes see also: //
@@ -45,6 +64,7 @@
 /////////////////////////////
 #include <TMath.h>
 #include <TApplication.h> //showing GUI
+#include <TROOT.h> //batch mode
 #include <TSystem.h> //System functions
 #include <TCanvas.h> //Canvas for Grahps
 #include <TFrame.h> //Frame for Graphs
@@ -274,10 +294,11 @@ void getFlask(string datapath, Data &data)
 
 };
 
-//getting Meteo Data from file
-void getMeteo(string datapath, Data &data)
+//getting Meteo Data from file, every row goes to the series of its year
+void getMeteo(string datapath, map<int, Data> &meteo)
 {
     string interval_r, windvel_r, contemp_r, rh1_r, rh2_r, grad_r, apress_r, o3g1_r, o3g3_r, no_r, ventemp_r, winddir_r, prec_r;
+    TimeStamp time_stamp;
     //loop over alle files
     ifstream inFile (datapath);
     string name = datapath.substr(datapath.size()-27,27);
@@ -287,7 +308,10 @@ void getMeteo(string datapath, Data &data)
 	if (inFile.is_open())
 	{
         int i = 0;
+        LogTally &bad_row = logger.tally("meteo rows not readable");
         string line;
+        int year_last = 0;
+        Data *series = nullptr;
 
         while (getline(inFile, line))
 		{
@@ -307,12 +331,23 @@ void getMeteo(string datapath, Data &data)
             getline(stst,ventemp_r,';');
             getline(stst,winddir_r,';');
             getline(stst,prec_r,';');
+            //decode time "YYYY-MM-DD HH:MM:SS", spaces are already removed
+            if (!decodeTimestamp(interval_r, time_stamp))
+            {
+                bad_row.add("Problem reading Meteo at ", interval_r);
+                i++;
+                continue;
+            };
+            if (!series || time_stamp.year != year_last)
+            {
+                year_last = time_stamp.year;
+                series = &meteo[year_last];
+            };
+            Data &data = *series;
             try
             {
-                remove(interval_r.begin(), interval_r.end(), '-');
-                remove(interval_r.begin(), interval_r.end(), ':');
-
-                data.timed.push_back(stod(interval_r));
+                interval_r = to_string(static_cast<long long>(time_stamp.time_code));
+                data.timed.push_back(time_stamp.time_code);
                 data.windvel.push_back(stod(windvel_r));
                 data.contemp.push_back(stod(contemp_r));
                 data.rh1.push_back(stod(rh1_r));
@@ -328,17 +363,83 @@ void getMeteo(string datapath, Data &data)
                 data.month_str.push_back(interval_r.substr(4,2));
                 data.year.push_back(interval_r.substr(0,4));
                 data.timed_begin.push_back(stod(interval_r.substr(4,6)));
-                if (i == 20 || i == 40){cout << name << ": " << data.timed.back() << "||" << interval_r << "||" << windvel_r << "||" << contemp_r << "||" << rh1_r << "||" << rh2_r << "||" << grad_r << "||" << apress_r << "||" << o3g1_r << "||" << o3g3_r << "||" << no_r << "||" << ventemp_r << "||" << winddir_r << "||" << prec_r << endl;};
-                if (i == 20){cout << "Year " << interval_r.substr(0,4) << endl;};
+                if (i == 20 || i == 40){logger.info(name, ": ", data.timed.back(), "||", interval_r, "||", windvel_r, "||", contemp_r, "||", rh1_r, "||", rh2_r, "||", grad_r, "||", apress_r, "||", o3g1_r, "||", o3g3_r, "||", no_r, "||", ventemp_r, "||", winddir_r, "||", prec_r);};
+                if (i == 20){logger.info("Year ", interval_r.substr(0,4));};
             }
             catch (...)
             {
-                cout << "Problem reading Meteo at " << interval_r << endl;
+                bad_row.add("Problem reading Meteo at ", interval_r);
             }
             i++;
         };
 	};
     inFile.close();
+    logger.flush();
+};
+
+//meteo channels of the rain graphs, order of the enum
+enum MeteoChannel {ch_temp, ch_rh, ch_windvel, ch_winddir, ch_grad};
+vector<const vector<double>*> meteoChannels(Data &data_meteo)
+{
+    return {&data_meteo.ventemp, &data_meteo.rh2, &data_meteo.windvel, &data_meteo.winddir, &data_meteo.grad};
+};
+
+//meteo series of a year, empty if no meteo file has the year
+Data &meteoOfYear(map<int, Data> &data_meteo, int year)
+{
+    static Data none;
+    auto itr = data_meteo.find(year);
+    if (itr == data_meteo.end())
+    {
+        logger.warn("No meteo data of ", year);
+        return none;
+    };
+    return itr->second;
+};
+
+//line color of the k-th year, black, green, blue and orange as before, then the other ROOT colors
+int groupColor(size_t k)
+{
+    const int colors[10] = {1, 416, 600, 800, 632, 616, 432, 820, 880, 900};
+    return colors[k % 10] + 2 * static_cast<int>(k / 10);
+};
+
+//rows of the samples of every year found in a year column, one pass, years ascending
+class YearGroups
+{
+public:
+    vector<string> year; //name of every group
+    vector<int> color;
+    vector<vector<size_t>> rows;
+
+    YearGroups(const vector<string> &year_column)
+    {
+        map<int, vector<size_t>> by_year;
+        LogTally &no_year = logger.tally("rain samples without year");
+        for (size_t i = 0; i < year_column.size(); i++)
+        {
+            int y = atoi(year_column[i].c_str());
+            if (y <= 0){no_year.add("No year at sample ", i+1, ": ", year_column[i]); continue;};
+            by_year[y].push_back(i);
+        };
+        for (auto &group : by_year)
+        {
+            color.push_back(groupColor(year.size()));
+            year.push_back(to_string(group.first));
+            rows.push_back(group.second);
+        };
+        logger.flush();
+    };
+    int size() const {return year.size();};
+    //rows of pads of a canvas with two columns
+    int padRows() const {return size() > 0 ? (size() + 1) / 2 : 1;};
+};
+
+//time code YYYYMMDDHHMMSS of the first second of a month, month 13 is January of next year
+double monthTimeCode(int year, int month)
+{
+    if(month > 12){year++; month = 1;};
+    return ((year*100. + month)*100. + 1.)*1000000.;
 };
 
 // draw Graph
@@ -352,27 +453,20 @@ void drawEventGraph(Data &data, string evalpath)
     string Dextitle = "D-excess Graph;Month of Year;D_{excess}";
     string H2Otitle = "Precipitation Graph;Month of Year;H_{2}O[g]";
 
-    vector<vector<double>> xO18,xH2,xDex,xH2O;
-    vector<vector<double>> yO18,yH2,yDex,yH2O;
-
-    vector<string> year;
-
-    vector<int> color;
-
-    for(int i = 0; i < 4; i++)
+    //samples of every year found in the data
+    YearGroups groups(data.year);
+    int n = groups.size();
+    vector<string> &year = groups.year;
+    vector<int> &color = groups.color;
+    vector<vector<double>> xMonth(n);
+    vector<vector<double>> yO18(n),yH2(n),yDex(n),yH2O(n);
+    for(int k = 0; k < n; k++)
     {
-        xO18.push_back(vector<double>());
-        xH2.push_back(vector<double>());
-        xDex.push_back(vector<double>());
-        xH2O.push_back(vector<double>());
-        yO18.push_back(vector<double>());
-        yH2.push_back(vector<double>());
-        yDex.push_back(vector<double>());
-        yH2O.push_back(vector<double>());
-        if(i == 0){year.push_back("2018");color.push_back(1);}; //black
-        if(i == 1){year.push_back("2019");color.push_back(416);}; //gren
-        if(i == 2){year.push_back("2020");color.push_back(600);}; //blue
-        if(i == 3){year.push_back("2021");color.push_back(800);};  //orange
+        xMonth[k] = pickRows(data.month, groups.rows[k]);
+        yO18[k] = pickRows(data.O18, groups.rows[k]);
+        yH2[k] = pickRows(data.H2, groups.rows[k]);
+        yDex[k] = pickRows(data.D_excess, groups.rows[k]);
+        yH2O[k] = pickRows(data.H2O_m, groups.rows[k]);
     };
     int width = 8000;
     int height = 3000;
@@ -391,31 +485,12 @@ void drawEventGraph(Data &data, string evalpath)
     TMultiGraph *mgH2O = new TMultiGraph();
     mgH2O->SetTitle(H2Otitle.c_str());
     vector<TGraph*> grO18, grH2, grDex, grH2O;
-    for(int i = 0; i < data.O18.size();i++)
+    for(int i = 0; i < n; i++)
     {
-        if(data.year[i] == "2018"){xO18[0].push_back(data.month[i]);yO18[0].push_back(data.O18[i]);};
-        if(data.year[i] == "2019"){xO18[1].push_back(data.month[i]);yO18[1].push_back(data.O18[i]);};
-        if(data.year[i] == "2020"){xO18[2].push_back(data.month[i]);yO18[2].push_back(data.O18[i]);};
-        if(data.year[i] == "2021"){xO18[3].push_back(data.month[i]);yO18[3].push_back(data.O18[i]);};
-        if(data.year[i] == "2018"){xH2[0].push_back(data.month[i]);yH2[0].push_back(data.H2[i]);};
-        if(data.year[i] == "2019"){xH2[1].push_back(data.month[i]);yH2[1].push_back(data.H2[i]);};
-        if(data.year[i] == "2020"){xH2[2].push_back(data.month[i]);yH2[2].push_back(data.H2[i]);};
-        if(data.year[i] == "2021"){xH2[3].push_back(data.month[i]);yH2[3].push_back(data.H2[i]);};
-        if(data.year[i] == "2018"){xDex[0].push_back(data.month[i]);yDex[0].push_back(data.D_excess[i]);};
-        if(data.year[i] == "2019"){xDex[1].push_back(data.month[i]);yDex[1].push_back(data.D_excess[i]);};
-        if(data.year[i] == "2020"){xDex[2].push_back(data.month[i]);yDex[2].push_back(data.D_excess[i]);};
-        if(data.year[i] == "2021"){xDex[3].push_back(data.month[i]);yDex[3].push_back(data.D_excess[i]);};
-        if(data.year[i] == "2018"){xH2O[0].push_back(data.month[i]);yH2O[0].push_back(data.H2O_m[i]);};
-        if(data.year[i] == "2019"){xH2O[1].push_back(data.month[i]);yH2O[1].push_back(data.H2O_m[i]);};
-        if(data.year[i] == "2020"){xH2O[2].push_back(data.month[i]);yH2O[2].push_back(data.H2O_m[i]);};
-        if(data.year[i] == "2021"){xH2O[3].push_back(data.month[i]);yH2O[3].push_back(data.H2O_m[i]);};
-    };
-    for(int i = 0; i < 4; i++)
-    {
-        grO18.push_back(new TGraph(xO18[i].size(),xO18[i].data(),yO18[i].data()));
-        grH2.push_back(new TGraph(xH2[i].size(),xH2[i].data(),yH2[i].data()));
-        grDex.push_back(new TGraph(xDex[i].size(),xDex[i].data(),yDex[i].data()));
-        grH2O.push_back(new TGraph(xH2O[i].size(),xH2O[i].data(),yH2O[i].data()));
+        grO18.push_back(new TGraph(xMonth[i].size(),xMonth[i].data(),yO18[i].data()));
+        grH2.push_back(new TGraph(xMonth[i].size(),xMonth[i].data(),yH2[i].data()));
+        grDex.push_back(new TGraph(xMonth[i].size(),xMonth[i].data(),yDex[i].data()));
+        grH2O.push_back(new TGraph(xMonth[i].size(),xMonth[i].data(),yH2O[i].data()));
 
         grO18[i]->SetTitle(year[i].c_str());grH2[i]->SetTitle(year[i].c_str());grDex[i]->SetTitle(year[i].c_str());grH2O[i]->SetTitle(year[i].c_str());
         grO18[i]->SetMarkerStyle(43);grH2[i]->SetMarkerStyle(43);grDex[i]->SetMarkerStyle(43);grH2O[i]->SetMarkerStyle(43);
@@ -461,10 +536,10 @@ void drawEventGraph(Data &data, string evalpath)
 
     vector<TGraph*> grLMWL;
     vector<TF1*> linFit;
-    TCanvas *cLMWL = new TCanvas("LMWL","LMWL",0,0,2000,2000);
-    cLMWL->Divide(2,2);
+    TCanvas *cLMWL = new TCanvas("LMWL","LMWL",0,0,2000,1000*groups.padRows());
+    cLMWL->Divide(2,groups.padRows());
     vector<string> LMWLtitle;
-    for(int i = 0; i < 4; i++)
+    for(int i = 0; i < n; i++)
     {
         cLMWL->cd(i+1);
         LMWLtitle.push_back("LMWL " + year[i] + ";#delta{}^{18}O;#delta{}^{2}H");
@@ -490,131 +565,38 @@ void drawEventGraph(Data &data, string evalpath)
 };
 
 //draw Graph Event Meteo
-void drawEventMeteoGraph(Data &data, vector<Data> &data_meteo, string evalpath)
+void drawEventMeteoGraph(Data &data, map<int, Data> &data_meteo, string evalpath)
 {
-    vector<double> temp, rh, windvel, winddir, grad;
-    vector<string> month, year;
-
-    vector<vector<double>> xTemp,xRh,xWindvel, xWinddir, xGrad;
-    vector<vector<double>> yO18,yH2,yDex;
-    vector<int> color;
-
-    //preparing vectors
-    for(int i = 0; i < 4; i++)
+    //samples of every year found in the data
+    YearGroups groups(data.year);
+    int n = groups.size();
+    vector<string> &year = groups.year;
+    vector<int> &color = groups.color;
+    int block = 2*groups.padRows(); //pads of O18, H2 and D-excess
+    vector<vector<double>> xTemp(n),xRh(n),xWindvel(n),xWinddir(n),xGrad(n);
+    vector<vector<double>> yO18(n),yH2(n),yDex(n);
+
+    //meteo during every event, one sweep over the meteo series of the year
+    for(int k = 0; k < n; k++)
     {
-        xTemp.push_back(vector<double>());
-        xRh.push_back(vector<double>());
-        xWindvel.push_back(vector<double>());
-        xWinddir.push_back(vector<double>());
-        xGrad.push_back(vector<double>());
-        yO18.push_back(vector<double>());
-        yH2.push_back(vector<double>());
-        yDex.push_back(vector<double>());
-        if(i == 0){year.push_back("2018");color.push_back(1);};
-        if(i == 1){year.push_back("2019");color.push_back(416);};
-        if(i == 2){year.push_back("2020");color.push_back(600);};
-        if(i == 3){year.push_back("2021");color.push_back(800);};
-    };
-
-    for(int i = 0; i < data.timed_begin.size(); i++)
-    {
-        temp.clear();
-        rh.clear();
-        windvel.clear();
-        winddir.clear();
-        grad.clear();
-
-        if(data.year[i] == "2018")
-        {
-            cout << "Year read and compare " << data.year[i] << endl;
-            for(int j = 0; j < data_meteo[0].timed.size(); j++)
-            {
-                if(i == 0 && j == 0)
-                {
-                    cout << "Time compare " << data.timed_begin[i] << "||" << data_meteo[0].timed_begin[0] << "||" << data.timed_end[i] << endl;
-                }
-                if(data_meteo[0].timed_begin[j] >= data.timed_begin[i] &&  data_meteo[0].timed_begin[j] < data.timed_end[i])
-                {
-                    temp.push_back(data_meteo[0].ventemp[j]);
-                    rh.push_back(data_meteo[0].rh2[j]);
-                    windvel.push_back(data_meteo[0].windvel[j]);
-                    winddir.push_back(data_meteo[0].winddir[j]);
-                    grad.push_back(data_meteo[0].grad[j]);
-                    if(i == 0)
-                    {
-                        cout << "Data meteo: " << data_meteo[0].ventemp[j] << "||" << data_meteo[0].rh2[j] << "||" << data_meteo[0].windvel[j] << "||" << data_meteo[0].winddir[j] << "||" << data_meteo[0].grad[j] << endl;
-                    };
-                };
-            };
-            cout << "Averaging in " << data.year[i] << "||" << TMath::Mean(temp.begin(),temp.end()) << endl;
-            xTemp[0].push_back(TMath::Mean(temp.begin(),temp.end()));
-            xRh[0].push_back(TMath::Mean(rh.begin(),rh.end()));
-            xWindvel[0].push_back(TMath::Mean(windvel.begin(),windvel.end()));
-            xWinddir[0].push_back(TMath::Mean(winddir.begin(),winddir.end()));
-            xGrad[0].push_back(TMath::Mean(grad.begin(),grad.end()));
-        };
-        if(data.year[i] == "2019")
-        {
-            cout << "Year read and compare " << data.year[i] << endl;
-            for(int j = 0; j < data_meteo[1].timed.size(); j++)
-            {
-                if(data_meteo[1].timed_begin[j] >= data.timed_begin[i] &&  data_meteo[1].timed_begin[j] < data.timed_end[i])
-                {
-                    temp.push_back(data_meteo[1].ventemp[j]);
-                    rh.push_back(data_meteo[1].rh2[j]);
-                    windvel.push_back(data_meteo[1].windvel[j]);
-                    winddir.push_back(data_meteo[1].winddir[j]);
-                    grad.push_back(data_meteo[1].grad[j]);
-                };
-            };
-            cout << "Averaging in " << data.year[i] << "||" << TMath::Mean(temp.begin(),temp.end()) << endl;
-            xTemp[1].push_back(TMath::Mean(temp.begin(),temp.end()));
-            xRh[1].push_back(TMath::Mean(rh.begin(),rh.end()));
-            xWindvel[1].push_back(TMath::Mean(windvel.begin(),windvel.end()));
-            xWinddir[1].push_back(TMath::Mean(winddir.begin(),winddir.end()));
-            xGrad[1].push_back(TMath::Mean(grad.begin(),grad.end()));
-        };
-        if(data.year[i] == "2020")
+        vector<double> begin, end;
+        for(size_t i : groups.rows[k])
         {
-            cout << "Year read and compare " << data.year[i] << endl;
-            for(int j = 0; j < data_meteo[2].timed.size(); j++)
-            {
-                if(data_meteo[2].timed_begin[j] >= data.timed_begin[i] &&  data_meteo[2].timed_begin[j] < data.timed_end[i])
-                {
-                    temp.push_back(data_meteo[2].ventemp[j]);
-                    rh.push_back(data_meteo[2].rh2[j]);
-                    windvel.push_back(data_meteo[2].windvel[j]);
-                    winddir.push_back(data_meteo[2].winddir[j]);
-                    grad.push_back(data_meteo[2].grad[j]);
-                };
-            };
-            cout << "Averaging in " << data.year[i] << "||" << TMath::Mean(temp.begin(),temp.end()) << endl;
-            xTemp[2].push_back(TMath::Mean(temp.begin(),temp.end()));
-            xRh[2].push_back(TMath::Mean(rh.begin(),rh.end()));
-            xWindvel[2].push_back(TMath::Mean(windvel.begin(),windvel.end()));
-            xWinddir[2].push_back(TMath::Mean(winddir.begin(),winddir.end()));
-            xGrad[2].push_back(TMath::Mean(grad.begin(),grad.end()));
+            //YYYYMMDDhh00 to time code of the meteo file
+            begin.push_back(data.time_begin[i]*100.);
+            end.push_back(data.time_end[i]*100.);
         };
-        if(data.year[i] == "2021")
+        cout << "Year read and compare " << year[k] << " with " << begin.size() << " events" << endl;
+        Data &meteo = meteoOfYear(data_meteo, stoi(year[k]));
+        vector<vector<IntervalStats>> stats = aggregateIntervals(begin, end, meteo.timed, meteoChannels(meteo));
+        for(int i = 0; i < stats.size(); i++)
         {
-            cout << "Year read and compare " << data.year[i] << endl;
-            for(int j = 0; j < data_meteo[3].timed.size(); j++)
-            {
-                if(data_meteo[3].timed_begin[j] >= data.timed_begin[i] &&  data_meteo[3].timed_begin[j] < data.timed_end[i])
-                {
-                    temp.push_back(data_meteo[3].ventemp[j]);
-                    rh.push_back(data_meteo[3].rh2[j]);
-                    windvel.push_back(data_meteo[3].windvel[j]);
-                    winddir.push_back(data_meteo[3].winddir[j]);
-                    grad.push_back(data_meteo[3].grad[j]);
-                };
-            };
-            cout << "Averaging in " << data.year[i] << "||" << TMath::Mean(temp.begin(),temp.end()) << endl;
-            xTemp[3].push_back(TMath::Mean(temp.begin(),temp.end()));
-            xRh[3].push_back(TMath::Mean(rh.begin(),rh.end()));
-            xWindvel[3].push_back(TMath::Mean(windvel.begin(),windvel.end()));
-            xWinddir[3].push_back(TMath::Mean(winddir.begin(),winddir.end()));
-            xGrad[3].push_back(TMath::Mean(grad.begin(),grad.end()));
+            cout << "Averaging in " << year[k] << "||" << stats[i][ch_temp].mean << "+-" << stats[i][ch_temp].stdev << " from " << stats[i][ch_temp].count << endl;
+            xTemp[k].push_back(stats[i][ch_temp].mean);
+            xRh[k].push_back(stats[i][ch_rh].mean);
+            xWindvel[k].push_back(stats[i][ch_windvel].mean);
+            xWinddir[k].push_back(stats[i][ch_winddir].mean);
+            xGrad[k].push_back(stats[i][ch_grad].mean);
         };
     };
 
@@ -626,20 +608,11 @@ void drawEventMeteoGraph(Data &data, vector<Data> &data_meteo, string evalpath)
         };
     };
 
-    for(int i = 0; i < data.O18.size();i++)
+    for(int k = 0; k < n; k++)
     {
-        if(data.year[i] == "2018"){yO18[0].push_back(data.O18[i]);};
-        if(data.year[i] == "2019"){yO18[1].push_back(data.O18[i]);};
-        if(data.year[i] == "2020"){yO18[2].push_back(data.O18[i]);};
-        if(data.year[i] == "2021"){yO18[3].push_back(data.O18[i]);};
-        if(data.year[i] == "2018"){yH2[0].push_back(data.H2[i]);};
-        if(data.year[i] == "2019"){yH2[1].push_back(data.H2[i]);};
-        if(data.year[i] == "2020"){yH2[2].push_back(data.H2[i]);};
-        if(data.year[i] == "2021"){yH2[3].push_back(data.H2[i]);};
-        if(data.year[i] == "2018"){yDex[0].push_back(data.D_excess[i]);};
-        if(data.year[i] == "2019"){yDex[1].push_back(data.D_excess[i]);};
-        if(data.year[i] == "2020"){yDex[2].push_back(data.D_excess[i]);};
-        if(data.year[i] == "2021"){yDex[3].push_back(data.D_excess[i]);};
+        yO18[k] = pickRows(data.O18, groups.rows[k]);
+        yH2[k] = pickRows(data.H2, groups.rows[k]);
+        yDex[k] = pickRows(data.D_excess, groups.rows[k]);
     };
 
     string name_file_temp = evalpath + "/End/Temperature_Event.png";
@@ -661,13 +634,13 @@ void drawEventMeteoGraph(Data &data, vector<Data> &data_meteo, string evalpath)
     int width = 2000;
     int height = 2000;
 
-    TCanvas *cTemp = new TCanvas("Temp","Temp",0,0,width,height*3);
-    cTemp->Divide(2,6);
+    TCanvas *cTemp = new TCanvas("Temp","Temp",0,0,width,height*3*groups.padRows()/2);
+    cTemp->Divide(2,3*groups.padRows());
     cTemp->GetFrame()->SetBorderSize(12);
     cTemp->SetGrid();
     vector<TGraph*> grTempO18, grTempH2, grTempDex;
 
-    for(int i = 0; i < 4; i++)
+    for(int i = 0; i < n; i++)
     {
         grTempO18.push_back(new TGraph(yO18[i].size(),xTemp[i].data(),yO18[i].data()));
         grTempH2.push_back(new TGraph(yH2[i].size(),xTemp[i].data(),yH2[i].data()));
@@ -680,8 +653,8 @@ void drawEventMeteoGraph(Data &data, vector<Data> &data_meteo, string evalpath)
         grTempO18[i]->SetLineWidth(8);grTempH2[i]->SetLineWidth(8);grTempDex[i]->SetLineWidth(8);
         grTempO18[i]->SetLineColor(color[i]);grTempH2[i]->SetLineColor(color[i]);grTempDex[i]->SetLineColor(color[i]);
         cTemp->cd(i+1);grTempO18[i]->Draw("AP");
-        cTemp->cd(i+5);grTempH2[i]->Draw("AP");
-        cTemp->cd(i+9);grTempDex[i]->Draw("AP");
+        cTemp->cd(i+1+block);grTempH2[i]->Draw("AP");
+        cTemp->cd(i+1+2*block);grTempDex[i]->Draw("AP");
     };
     cTemp->Update();
     cTemp->Update();
@@ -690,13 +663,13 @@ void drawEventMeteoGraph(Data &data, vector<Data> &data_meteo, string evalpath)
     cTemp->Print(name_file_temp.c_str());
     cTemp->Close();
 
-    TCanvas *cRH = new TCanvas("RH","RH",0,0,width,height*3);
-    cRH->Divide(2,6);
+    TCanvas *cRH = new TCanvas("RH","RH",0,0,width,height*3*groups.padRows()/2);
+    cRH->Divide(2,3*groups.padRows());
     cRH->GetFrame()->SetBorderSize(12);
     cRH->SetGrid();
     vector<TGraph*> grRHO18, grRHH2, grRHDex;
 
-    for(int i = 0; i < 4; i++)
+    for(int i = 0; i < n; i++)
     {
         grRHO18.push_back(new TGraph(yO18[i].size(),xRh[i].data(),yO18[i].data()));
         grRHH2.push_back(new TGraph(yH2[i].size(),xRh[i].data(),yH2[i].data()));
@@ -709,8 +682,8 @@ void drawEventMeteoGraph(Data &data, vector<Data> &data_meteo, string evalpath)
         grRHO18[i]->SetLineWidth(8);grRHH2[i]->SetLineWidth(8);grRHDex[i]->SetLineWidth(8);
         grRHO18[i]->SetLineColor(color[i]);grRHH2[i]->SetLineColor(color[i]);grRHDex[i]->SetLineColor(color[i]);
         cRH->cd(i+1);grRHO18[i]->Draw("AP");
-        cRH->cd(i+5);grRHH2[i]->Draw("AP");
-        cRH->cd(i+9);grRHDex[i]->Draw("AP");
+        cRH->cd(i+1+block);grRHH2[i]->Draw("AP");
+        cRH->cd(i+1+2*block);grRHDex[i]->Draw("AP");
     };
     cRH->Update();
     cRH->Update();
@@ -719,13 +692,13 @@ void drawEventMeteoGraph(Data &data, vector<Data> &data_meteo, string evalpath)
     cRH->Print(name_file_rh.c_str());
     cRH->Close();
 
-    TCanvas *cWindvel = new TCanvas("Windvel","Windvel",0,0,width,height*3);
-    cWindvel->Divide(2,6);
+    TCanvas *cWindvel = new TCanvas("Windvel","Windvel",0,0,width,height*3*groups.padRows()/2);
+    cWindvel->Divide(2,3*groups.padRows());
     cWindvel->GetFrame()->SetBorderSize(12);
     cWindvel->SetGrid();
     vector<TGraph*> grWVO18, grWVH2, grWVDex;
 
-    for(int i = 0; i < 4; i++)
+    for(int i = 0; i < n; i++)
     {
         grWVO18.push_back(new TGraph(yO18[i].size(),xWindvel[i].data(),yO18[i].data()));
         grWVH2.push_back(new TGraph(yH2[i].size(),xWindvel[i].data(),yH2[i].data()));
@@ -738,8 +711,8 @@ void drawEventMeteoGraph(Data &data, vector<Data> &data_meteo, string evalpath)
         grWVO18[i]->SetLineWidth(8);grWVH2[i]->SetLineWidth(8);grWVDex[i]->SetLineWidth(8);
         grWVO18[i]->SetLineColor(color[i]);grWVH2[i]->SetLineColor(color[i]);grWVDex[i]->SetLineColor(color[i]);
         cWindvel->cd(i+1);grWVO18[i]->Draw("AP");
-        cWindvel->cd(i+5);grWVH2[i]->Draw("AP");
-        cWindvel->cd(i+9);grWVDex[i]->Draw("AP");
+        cWindvel->cd(i+1+block);grWVH2[i]->Draw("AP");
+        cWindvel->cd(i+1+2*block);grWVDex[i]->Draw("AP");
     };
     cWindvel->Update();
     cWindvel->Update();
@@ -748,13 +721,13 @@ void drawEventMeteoGraph(Data &data, vector<Data> &data_meteo, string evalpath)
     cWindvel->Print(name_file_windvel.c_str());
     cWindvel->Close();
 
-    TCanvas *cWinddir = new TCanvas("Winddir","Winddir",0,0,width,height*3);
-    cWinddir->Divide(2,6);
+    TCanvas *cWinddir = new TCanvas("Winddir","Winddir",0,0,width,height*3*groups.padRows()/2);
+    cWinddir->Divide(2,3*groups.padRows());
     cWinddir->GetFrame()->SetBorderSize(12);
     cWinddir->SetGrid();
     vector<TGraph*> grWDO18, grWDH2, grWDDex;
 
-    for(int i = 0; i < 4; i++)
+    for(int i = 0; i < n; i++)
     {
         grWDO18.push_back(new TGraph(yO18[i].size(),xWinddir[i].data(),yO18[i].data()));
         grWDH2.push_back(new TGraph(yH2[i].size(),xWinddir[i].data(),yH2[i].data()));
@@ -767,8 +740,8 @@ void drawEventMeteoGraph(Data &data, vector<Data> &data_meteo, string evalpath)
         grWDO18[i]->SetLineWidth(8);grWDH2[i]->SetLineWidth(8);grWDDex[i]->SetLineWidth(8);
         grWDO18[i]->SetLineColor(color[i]);grWDH2[i]->SetLineColor(color[i]);grWDDex[i]->SetLineColor(color[i]);
         cWinddir->cd(i+1);grWDO18[i]->Draw("AP");
-        cWinddir->cd(i+5);grWDH2[i]->Draw("AP");
-        cWinddir->cd(i+9);grWDDex[i]->Draw("AP");
+        cWinddir->cd(i+1+block);grWDH2[i]->Draw("AP");
+        cWinddir->cd(i+1+2*block);grWDDex[i]->Draw("AP");
     };
     cWinddir->Update();
     cWinddir->Update();
@@ -777,13 +750,13 @@ void drawEventMeteoGraph(Data &data, vector<Data> &data_meteo, string evalpath)
     cWinddir->Print(name_file_winddir.c_str());
     cWinddir->Close();
 
-    TCanvas *cGrad = new TCanvas("Grad","Grad",0,0,width,height*3);
-    cGrad->Divide(2,6);
+    TCanvas *cGrad = new TCanvas("Grad","Grad",0,0,width,height*3*groups.padRows()/2);
+    cGrad->Divide(2,3*groups.padRows());
     cGrad->GetFrame()->SetBorderSize(12);
     cGrad->SetGrid();
     vector<TGraph*> grGRADO18, grGRADH2, grGRADDex;
 
-    for(int i = 0; i < 4; i++)
+    for(int i = 0; i < n; i++)
     {
         grGRADO18.push_back(new TGraph(yO18[i].size(),xGrad[i].data(),yO18[i].data()));
         grGRADH2.push_back(new TGraph(yH2[i].size(),xGrad[i].data(),yH2[i].data()));
@@ -796,8 +769,8 @@ void drawEventMeteoGraph(Data &data, vector<Data> &data_meteo, string evalpath)
         grGRADO18[i]->SetLineWidth(8);grGRADH2[i]->SetLineWidth(8);grGRADDex[i]->SetLineWidth(8);
         grGRADO18[i]->SetLineColor(color[i]);grGRADH2[i]->SetLineColor(color[i]);grGRADDex[i]->SetLineColor(color[i]);
         cGrad->cd(i+1);grGRADO18[i]->Draw("AP");
-        cGrad->cd(i+5);grGRADH2[i]->Draw("AP");
-        cGrad->cd(i+9);grGRADDex[i]->Draw("AP");
+        cGrad->cd(i+1+block);grGRADH2[i]->Draw("AP");
+        cGrad->cd(i+1+2*block);grGRADDex[i]->Draw("AP");
     };
     cGrad->Update();
     cGrad->Update();
@@ -876,27 +849,20 @@ void drawMonthGraph(Data &data, string evalpath)
     string Dextitle = "D-excess Graph;Month of Year;D_{excess}";
     string H2Otitle = "Precipitation Graph;Month of Year;H_{2}O[g]";
 
-    vector<vector<double>> xO18,xH2,xDex,xH2O;
-    vector<vector<double>> yO18,yH2,yDex,yH2O;
-
-    vector<string> year;
-
-    vector<int> color;
-
-    for(int i = 0; i < 4; i++)
+    //samples of every year found in the data
+    YearGroups groups(data.year);
+    int n = groups.size();
+    vector<string> &year = groups.year;
+    vector<int> &color = groups.color;
+    vector<vector<double>> xMonth(n);
+    vector<vector<double>> yO18(n),yH2(n),yDex(n),yH2O(n);
+    for(int k = 0; k < n; k++)
     {
-        xO18.push_back(vector<double>());
-        xH2.push_back(vector<double>());
-        xDex.push_back(vector<double>());
-        xH2O.push_back(vector<double>());
-        yO18.push_back(vector<double>());
-        yH2.push_back(vector<double>());
-        yDex.push_back(vector<double>());
-        yH2O.push_back(vector<double>());
-        if(i == 0){year.push_back("2018");color.push_back(1);};
-        if(i == 1){year.push_back("2019");color.push_back(416);};
-        if(i == 2){year.push_back("2020");color.push_back(600);};
-        if(i == 3){year.push_back("2021");color.push_back(800);};
+        xMonth[k] = pickRows(data.month, groups.rows[k]);
+        yO18[k] = pickRows(data.O18, groups.rows[k]);
+        yH2[k] = pickRows(data.H2, groups.rows[k]);
+        yDex[k] = pickRows(data.D_excess, groups.rows[k]);
+        yH2O[k] = pickRows(data.H2O_m, groups.rows[k]);
     };
     int width = 8000;
     int height = 3000;
@@ -915,31 +881,12 @@ void drawMonthGraph(Data &data, string evalpath)
     TMultiGraph *mgH2O = new TMultiGraph();
     mgH2O->SetTitle(H2Otitle.c_str());
     vector<TGraph*> grO18, grH2, grDex, grH2O;
-    for(int i = 0; i < data.O18.size();i++)
+    for(int i = 0; i < n; i++)
     {
-        if(data.year[i] == "2018"){xO18[0].push_back(data.month[i]);yO18[0].push_back(data.O18[i]);};
-        if(data.year[i] == "2019"){xO18[1].push_back(data.month[i]);yO18[1].push_back(data.O18[i]);};
-        if(data.year[i] == "2020"){xO18[2].push_back(data.month[i]);yO18[2].push_back(data.O18[i]);};
-        if(data.year[i] == "2021"){xO18[3].push_back(data.month[i]);yO18[3].push_back(data.O18[i]);};
-        if(data.year[i] == "2018"){xH2[0].push_back(data.month[i]);yH2[0].push_back(data.H2[i]);};
-        if(data.year[i] == "2019"){xH2[1].push_back(data.month[i]);yH2[1].push_back(data.H2[i]);};
-        if(data.year[i] == "2020"){xH2[2].push_back(data.month[i]);yH2[2].push_back(data.H2[i]);};
-        if(data.year[i] == "2021"){xH2[3].push_back(data.month[i]);yH2[3].push_back(data.H2[i]);};
-        if(data.year[i] == "2018"){xDex[0].push_back(data.month[i]);yDex[0].push_back(data.D_excess[i]);};
-        if(data.year[i] == "2019"){xDex[1].push_back(data.month[i]);yDex[1].push_back(data.D_excess[i]);};
-        if(data.year[i] == "2020"){xDex[2].push_back(data.month[i]);yDex[2].push_back(data.D_excess[i]);};
-        if(data.year[i] == "2021"){xDex[3].push_back(data.month[i]);yDex[3].push_back(data.D_excess[i]);};
-        if(data.year[i] == "2018"){xH2O[0].push_back(data.month[i]);yH2O[0].push_back(data.H2O_m[i]);};
-        if(data.year[i] == "2019"){xH2O[1].push_back(data.month[i]);yH2O[1].push_back(data.H2O_m[i]);};
-        if(data.year[i] == "2020"){xH2O[2].push_back(data.month[i]);yH2O[2].push_back(data.H2O_m[i]);};
-        if(data.year[i] == "2021"){xH2O[3].push_back(data.month[i]);yH2O[3].push_back(data.H2O_m[i]);};
-    };
-    for(int i = 0; i < 4; i++)
-    {
-        grO18.push_back(new TGraph(xO18[i].size(),xO18[i].data(),yO18[i].data()));
-        grH2.push_back(new TGraph(xH2[i].size(),xH2[i].data(),yH2[i].data()));
-        grDex.push_back(new TGraph(xDex[i].size(),xDex[i].data(),yDex[i].data()));
-        grH2O.push_back(new TGraph(xH2O[i].size(),xH2O[i].data(),yH2O[i].data()));
+        grO18.push_back(new TGraph(xMonth[i].size(),xMonth[i].data(),yO18[i].data()));
+        grH2.push_back(new TGraph(xMonth[i].size(),xMonth[i].data(),yH2[i].data()));
+        grDex.push_back(new TGraph(xMonth[i].size(),xMonth[i].data(),yDex[i].data()));
+        grH2O.push_back(new TGraph(xMonth[i].size(),xMonth[i].data(),yH2O[i].data()));
 
         grO18[i]->SetTitle(year[i].c_str());grH2[i]->SetTitle(year[i].c_str());grDex[i]->SetTitle(year[i].c_str());grH2O[i]->SetTitle(year[i].c_str());
         grO18[i]->SetMarkerStyle(43);grH2[i]->SetMarkerStyle(43);grDex[i]->SetMarkerStyle(43);grH2O[i]->SetMarkerStyle(43);
@@ -985,10 +932,10 @@ void drawMonthGraph(Data &data, string evalpath)
 
     vector<TGraph*> grLMWL;
     vector<TF1*> linFit;
-    TCanvas *cLMWL = new TCanvas("LMWL","LMWL",0,0,2000,2000);
-    cLMWL->Divide(2,2);
+    TCanvas *cLMWL = new TCanvas("LMWL","LMWL",0,0,2000,1000*groups.padRows());
+    cLMWL->Divide(2,groups.padRows());
     vector<string> LMWLtitle;
-    for(int i = 0; i < 4; i++)
+    for(int i = 0; i < n; i++)
     {
         cLMWL->cd(i+1);
         LMWLtitle.push_back("LMWL " + year[i] + ";#delta^{18}O;#delta^{2}H");
@@ -1014,77 +961,37 @@ void drawMonthGraph(Data &data, string evalpath)
 };
 
 //draw Graph Month Meteo
-void drawMonthMeteoGraph(Data &data, vector<Data> &data_meteo, string evalpath)
+void drawMonthMeteoGraph(Data &data, map<int, Data> &data_meteo, string evalpath)
 {
-    vector<double> temp, rh, windvel, winddir, grad;
-    vector<string> month, year;
-
-    vector<vector<double>> xTemp,xRh,xWindvel,xWinddir,xGrad;
-    vector<vector<double>> yO18,yH2,yDex;
-
-    vector<int> color;
-
-    //preparing vectors
-    for(int i = 0; i < 4; i++)
-    {
-        xTemp.push_back(vector<double>());
-        xRh.push_back(vector<double>());
-        xWindvel.push_back(vector<double>());
-        xWinddir.push_back(vector<double>());
-        xGrad.push_back(vector<double>());
-        yO18.push_back(vector<double>());
-        yH2.push_back(vector<double>());
-        yDex.push_back(vector<double>());
-        if(i == 0){year.push_back("2018");color.push_back(1);};
-        if(i == 1){year.push_back("2019");color.push_back(416);};
-        if(i == 2){year.push_back("2020");color.push_back(600);};
-        if(i == 3){year.push_back("2021");color.push_back(800);};
-    };
-    string last_month_str;
-    for(int i = 0; i < data_meteo.size(); i++)
+    //samples of every year found in the data
+    YearGroups groups(data.year);
+    int n = groups.size();
+    vector<string> &year = groups.year;
+    vector<int> &color = groups.color;
+    int block = 2*groups.padRows(); //pads of O18, H2 and D-excess
+    vector<vector<double>> xTemp(n),xRh(n),xWindvel(n),xWinddir(n),xGrad(n);
+    vector<vector<double>> yO18(n),yH2(n),yDex(n);
+    //meteo of the calendar month of every month sample, one sweep over the meteo series of the year
+    for(int k = 0; k < n; k++)
     {
-        last_month_str = "01";
-        for(int j = 0; j < data_meteo[i].timed.size(); j++)
+        vector<double> begin, end;
+        for(size_t i : groups.rows[k])
         {
-
-            if(data_meteo[i].month_str[j] != last_month_str)
-            {
-                //do average
-                xTemp[i].push_back(TMath::Mean(temp.begin(),temp.end()));
-                xRh[i].push_back(TMath::Mean(rh.begin(),rh.end()));
-                xWindvel[i].push_back(TMath::Mean(windvel.begin(),windvel.end()));
-                xWinddir[i].push_back(TMath::Mean(winddir.begin(),winddir.end()));
-                xGrad[i].push_back(TMath::Mean(grad.begin(),grad.end()));
-                //clear vectors
-                temp.clear();
-                rh.clear();
-                windvel.clear();
-                winddir.clear();
-                grad.clear();
-            };
-            temp.push_back(data_meteo[i].ventemp[j]);
-            rh.push_back(data_meteo[i].rh2[j]);
-            windvel.push_back(data_meteo[i].windvel[j]);
-            winddir.push_back(data_meteo[i].winddir[j]);
-            grad.push_back(data_meteo[i].grad[j]);
-            last_month_str = data_meteo[i].month_str[j];
-            if(j == data_meteo[i].timed.size()-1)
-            {
-                //do average
-                xTemp[i].push_back(TMath::Mean(temp.begin(),temp.end()));
-                xRh[i].push_back(TMath::Mean(rh.begin(),rh.end()));
-                xWindvel[i].push_back(TMath::Mean(windvel.begin(),windvel.end()));
-                xWinddir[i].push_back(TMath::Mean(winddir.begin(),winddir.end()));
-                xGrad[i].push_back(TMath::Mean(grad.begin(),grad.end()));
-                //clear vectors
-                cout << data_meteo[i].month_str[j] << " Month evaluated at year " << data_meteo[i].year[j] << endl;
-                temp.clear();
-                rh.clear();
-                windvel.clear();
-                winddir.clear();
-                grad.clear();
-            };
+            int month_i = static_cast<int>(data.month[i]);
+            begin.push_back(monthTimeCode(stoi(year[k]), month_i));
+            end.push_back(monthTimeCode(stoi(year[k]), month_i+1));
+        };
+        Data &meteo = meteoOfYear(data_meteo, stoi(year[k]));
+        vector<vector<IntervalStats>> stats = aggregateIntervals(begin, end, meteo.timed, meteoChannels(meteo));
+        for(int i = 0; i < stats.size(); i++)
+        {
+            xTemp[k].push_back(stats[i][ch_temp].mean);
+            xRh[k].push_back(stats[i][ch_rh].mean);
+            xWindvel[k].push_back(stats[i][ch_windvel].mean);
+            xWinddir[k].push_back(stats[i][ch_winddir].mean);
+            xGrad[k].push_back(stats[i][ch_grad].mean);
         };
+        cout << stats.size() << " Months evaluated at year " << year[k] << endl;
     };
     for(int i = 0; i < xTemp.size(); i ++)
     {
@@ -1094,20 +1001,11 @@ void drawMonthMeteoGraph(Data &data, vector<Data> &data_meteo, string evalpath)
         };
     };
 
-    for(int i = 0; i < data.O18.size();i++)
+    for(int k = 0; k < n; k++)
     {
-        if(data.year[i] == "2018"){yO18[0].push_back(data.O18[i]);};
-        if(data.year[i] == "2019"){yO18[1].push_back(data.O18[i]);};
-        if(data.year[i] == "2020"){yO18[2].push_back(data.O18[i]);};
-        if(data.year[i] == "2021"){yO18[3].push_back(data.O18[i]);};
-        if(data.year[i] == "2018"){yH2[0].push_back(data.H2[i]);};
-        if(data.year[i] == "2019"){yH2[1].push_back(data.H2[i]);};
-        if(data.year[i] == "2020"){yH2[2].push_back(data.H2[i]);};
-        if(data.year[i] == "2021"){yH2[3].push_back(data.H2[i]);};
-        if(data.year[i] == "2018"){yDex[0].push_back(data.D_excess[i]);};
-        if(data.year[i] == "2019"){yDex[1].push_back(data.D_excess[i]);};
-        if(data.year[i] == "2020"){yDex[2].push_back(data.D_excess[i]);};
-        if(data.year[i] == "2021"){yDex[3].push_back(data.D_excess[i]);};
+        yO18[k] = pickRows(data.O18, groups.rows[k]);
+        yH2[k] = pickRows(data.H2, groups.rows[k]);
+        yDex[k] = pickRows(data.D_excess, groups.rows[k]);
     };
 
     string name_file_temp = evalpath + "/End/Temperature_Month.png";
@@ -1161,13 +1059,13 @@ void drawMonthMeteoGraph(Data &data, vector<Data> &data_meteo, string evalpath)
     // xWinddir[3][6] = winddirmean;
     // xGrad[3][6] = gradmean;
 
-    TCanvas *cTemp = new TCanvas("Temp","Temp",0,0,width,height*3);
-    cTemp->Divide(2,6);
+    TCanvas *cTemp = new TCanvas("Temp","Temp",0,0,width,height*3*groups.padRows()/2);
+    cTemp->Divide(2,3*groups.padRows());
     cTemp->GetFrame()->SetBorderSize(12);
     cTemp->SetGrid();
     vector<TGraph*> grTempO18, grTempH2, grTempDex;
 
-    for(int i = 0; i < 4; i++)
+    for(int i = 0; i < n; i++)
     {
         grTempO18.push_back(new TGraph(yO18[i].size(),xTemp[i].data(),yO18[i].data()));
         grTempH2.push_back(new TGraph(yH2[i].size(),xTemp[i].data(),yH2[i].data()));
@@ -1180,8 +1078,8 @@ void drawMonthMeteoGraph(Data &data, vector<Data> &data_meteo, string evalpath)
         grTempO18[i]->SetLineWidth(8);grTempH2[i]->SetLineWidth(8);grTempDex[i]->SetLineWidth(8);
         grTempO18[i]->SetLineColor(color[i]);grTempH2[i]->SetLineColor(color[i]);grTempDex[i]->SetLineColor(color[i]);
         cTemp->cd(i+1);grTempO18[i]->Draw("AP");
-        cTemp->cd(i+5);grTempH2[i]->Draw("AP");
-        cTemp->cd(i+9);grTempDex[i]->Draw("AP");
+        cTemp->cd(i+1+block);grTempH2[i]->Draw("AP");
+        cTemp->cd(i+1+2*block);grTempDex[i]->Draw("AP");
     };
     cTemp->Update();
     cTemp->Update();
@@ -1190,13 +1088,13 @@ void drawMonthMeteoGraph(Data &data, vector<Data> &data_meteo, string evalpath)
     cTemp->Print(name_file_temp.c_str());
     cTemp->Close();
 
-    TCanvas *cRH = new TCanvas("RH","RH",0,0,width,height*3);
-    cRH->Divide(2,6);
+    TCanvas *cRH = new TCanvas("RH","RH",0,0,width,height*3*groups.padRows()/2);
+    cRH->Divide(2,3*groups.padRows());
     cRH->GetFrame()->SetBorderSize(12);
     cRH->SetGrid();
     vector<TGraph*> grRHO18, grRHH2, grRHDex;
 
-    for(int i = 0; i < 4; i++)
+    for(int i = 0; i < n; i++)
     {
         grRHO18.push_back(new TGraph(yO18[i].size(),xRh[i].data(),yO18[i].data()));
         grRHH2.push_back(new TGraph(yH2[i].size(),xRh[i].data(),yH2[i].data()));
@@ -1209,8 +1107,8 @@ void drawMonthMeteoGraph(Data &data, vector<Data> &data_meteo, string evalpath)
         grRHO18[i]->SetLineWidth(8);grRHH2[i]->SetLineWidth(8);grRHDex[i]->SetLineWidth(8);
         grRHO18[i]->SetLineColor(color[i]);grRHH2[i]->SetLineColor(color[i]);grRHDex[i]->SetLineColor(color[i]);
         cRH->cd(i+1);grRHO18[i]->Draw("AP");
-        cRH->cd(i+5);grRHH2[i]->Draw("AP");
-        cRH->cd(i+9);grRHDex[i]->Draw("AP");
+        cRH->cd(i+1+block);grRHH2[i]->Draw("AP");
+        cRH->cd(i+1+2*block);grRHDex[i]->Draw("AP");
     };
     cRH->Update();
     cRH->Update();
@@ -1219,13 +1117,13 @@ void drawMonthMeteoGraph(Data &data, vector<Data> &data_meteo, string evalpath)
     cRH->Print(name_file_rh.c_str());
     cRH->Close();
 
-    TCanvas *cWindvel = new TCanvas("Windvel","Windvel",0,0,width,height*3);
-    cWindvel->Divide(2,6);
+    TCanvas *cWindvel = new TCanvas("Windvel","Windvel",0,0,width,height*3*groups.padRows()/2);
+    cWindvel->Divide(2,3*groups.padRows());
     cWindvel->GetFrame()->SetBorderSize(12);
     cWindvel->SetGrid();
     vector<TGraph*> grWVO18, grWVH2, grWVDex;
 
-    for(int i = 0; i < 4; i++)
+    for(int i = 0; i < n; i++)
     {
         grWVO18.push_back(new TGraph(yO18[i].size(),xWindvel[i].data(),yO18[i].data()));
         grWVH2.push_back(new TGraph(yH2[i].size(),xWindvel[i].data(),yH2[i].data()));
@@ -1238,8 +1136,8 @@ void drawMonthMeteoGraph(Data &data, vector<Data> &data_meteo, string evalpath)
         grWVO18[i]->SetLineWidth(8);grWVH2[i]->SetLineWidth(8);grWVDex[i]->SetLineWidth(8);
         grWVO18[i]->SetLineColor(color[i]);grWVH2[i]->SetLineColor(color[i]);grWVDex[i]->SetLineColor(color[i]);
         cWindvel->cd(i+1);grWVO18[i]->Draw("AP");
-        cWindvel->cd(i+5);grWVH2[i]->Draw("AP");
-        cWindvel->cd(i+9);grWVDex[i]->Draw("AP");
+        cWindvel->cd(i+1+block);grWVH2[i]->Draw("AP");
+        cWindvel->cd(i+1+2*block);grWVDex[i]->Draw("AP");
     };
     cWindvel->Update();
     cWindvel->Update();
@@ -1248,13 +1146,13 @@ void drawMonthMeteoGraph(Data &data, vector<Data> &data_meteo, string evalpath)
     cWindvel->Print(name_file_windvel.c_str());
     cWindvel->Close();
 
-    TCanvas *cWinddir = new TCanvas("Winddir","Winddir",0,0,width,height*3);
-    cWinddir->Divide(2,6);
+    TCanvas *cWinddir = new TCanvas("Winddir","Winddir",0,0,width,height*3*groups.padRows()/2);
+    cWinddir->Divide(2,3*groups.padRows());
     cWinddir->GetFrame()->SetBorderSize(12);
     cWinddir->SetGrid();
     vector<TGraph*> grWDO18, grWDH2, grWDDex;
 
-    for(int i = 0; i < 4; i++)
+    for(int i = 0; i < n; i++)
     {
         grWDO18.push_back(new TGraph(yO18[i].size(),xWinddir[i].data(),yO18[i].data()));
         grWDH2.push_back(new TGraph(yH2[i].size(),xWinddir[i].data(),yH2[i].data()));
@@ -1267,8 +1165,8 @@ void drawMonthMeteoGraph(Data &data, vector<Data> &data_meteo, string evalpath)
         grWDO18[i]->SetLineWidth(8);grWDH2[i]->SetLineWidth(8);grWDDex[i]->SetLineWidth(8);
         grWDO18[i]->SetLineColor(color[i]);grWDH2[i]->SetLineColor(color[i]);grWDDex[i]->SetLineColor(color[i]);
         cWinddir->cd(i+1);grWDO18[i]->Draw("AP");
-        cWinddir->cd(i+5);grWDH2[i]->Draw("AP");
-        cWinddir->cd(i+9);grWDDex[i]->Draw("AP");
+        cWinddir->cd(i+1+block);grWDH2[i]->Draw("AP");
+        cWinddir->cd(i+1+2*block);grWDDex[i]->Draw("AP");
     };
     cWinddir->Update();
     cWinddir->Update();
@@ -1277,13 +1175,13 @@ void drawMonthMeteoGraph(Data &data, vector<Data> &data_meteo, string evalpath)
     cWinddir->Print(name_file_winddir.c_str());
     cWinddir->Close();
 
-    TCanvas *cGrad = new TCanvas("Grad","Grad",0,0,width,height*3);
-    cGrad->Divide(2,6);
+    TCanvas *cGrad = new TCanvas("Grad","Grad",0,0,width,height*3*groups.padRows()/2);
+    cGrad->Divide(2,3*groups.padRows());
     cGrad->GetFrame()->SetBorderSize(12);
     cGrad->SetGrid();
     vector<TGraph*> grGRADO18, grGRADH2, grGRADDex;
 
-    for(int i = 0; i < 4; i++)
+    for(int i = 0; i < n; i++)
     {
         grGRADO18.push_back(new TGraph(yO18[i].size(),xWinddir[i].data(),yO18[i].data()));
         grGRADH2.push_back(new TGraph(yH2[i].size(),xWinddir[i].data(),yH2[i].data()));
@@ -1296,8 +1194,8 @@ void drawMonthMeteoGraph(Data &data, vector<Data> &data_meteo, string evalpath)
         grGRADO18[i]->SetLineWidth(8);grGRADH2[i]->SetLineWidth(8);grGRADDex[i]->SetLineWidth(8);
         grGRADO18[i]->SetLineColor(color[i]);grGRADH2[i]->SetLineColor(color[i]);grGRADDex[i]->SetLineColor(color[i]);
         cGrad->cd(i+1);grGRADO18[i]->Draw("AP");
-        cGrad->cd(i+5);grGRADH2[i]->Draw("AP");
-        cGrad->cd(i+9);grGRADDex[i]->Draw("AP");
+        cGrad->cd(i+1+block);grGRADH2[i]->Draw("AP");
+        cGrad->cd(i+1+2*block);grGRADDex[i]->Draw("AP");
     };
     cGrad->Update();
     cGrad->Update();
@@ -1372,47 +1270,79 @@ void drawMonthMeteoGraph(Data &data, vector<Data> &data_meteo, string evalpath)
 
 int main(int argc, char* argv[])
 {
+    RunOptions options(argc, argv,
+        "  --event FILE       csv file with event based rain samples\n"
+        "  --month FILE       csv file with monthly rain samples\n"
+        "  --flask FILE       csv file with flask samples\n"
+        "  --meteo FILES      meteo .dat files of any years, separated by ','\n"
+        "  --output DIR       folder for evaluation\n"
+        "  --render N         figures drawn at the same time in worker processes (default all cores, 1 draws here)\n");
     //////////////////////////////////
     // Name, date and path to files //
     //////////////////////////////////
+    stage_report.setProgram("rainwater_eval");
     char const * lFilterPatterns[1]={"*.csv"};
     char const * lFilterPatternsm[1]={"*.dat"};
-    string datapath_event = tinyfd_openFileDialog("Choose File with Event data", ".", 1, lFilterPatterns, NULL, 0);
+    string datapath_event = options.openFile("event", "Choose File with Event data", 1, lFilterPatterns);
     cout << "Data Event file: " << datapath_event << endl;
-    string datapath_month = tinyfd_openFileDialog("Choose File with Month data", ".", 1, lFilterPatterns, NULL, 0);
+    string datapath_month = options.openFile("month", "Choose File with Month data", 1, lFilterPatterns);
     cout << "Data Month file: " << datapath_month << endl;
-    string datapath_flask = tinyfd_openFileDialog("Choose File with Flask data", ".", 1, lFilterPatterns, NULL, 0);
+    string datapath_flask = options.openFile("flask", "Choose File with Flask data", 1, lFilterPatterns);
     cout << "Data Flask file: " << datapath_flask << endl;
-    vector<string> datapath_meteo;
-    for(int i = 0; i < 4; i++)
+    vector<string> datapath_meteo = options.list("meteo");
+    if (!options.has("meteo"))
     {
-        datapath_meteo.push_back(tinyfd_openFileDialog("Choose File with Meteo data", ".", 1, lFilterPatternsm, NULL, 0));
-        cout << "Data meteo file:" << datapath_meteo[i] << endl;
+        //files are chosen until the dialog is cancelled
+        for(;;)
+        {
+            string path = options.openFile("meteo", "Choose File with Meteo data (cancel when done)", 1, lFilterPatternsm);
+            if (path.empty()){break;};
+            datapath_meteo.push_back(path);
+        };
     };
+    for(int i = 0; i < datapath_meteo.size(); i++){cout << "Data meteo file:" << datapath_meteo[i] << endl;};
 
     //choose directory for evaluation data
-    string evalpath = tinyfd_selectFolderDialog("Choose Folder for Evaluation", ".");
+    string evalpath = options.selectFolder("output", "Choose Folder for Evaluation");
     cout << "Evalpath " << evalpath << endl;
 
     //////////////////////////////////////////////////
     // Read files and store values //
     //////////////////////////////////////////////////
     Data data_event, data_month, data_flask;
-    vector<Data> data_meteo;
+    map<int, Data> data_meteo; //meteo series of every year
 
-    for(int i = 0; i < 4; i++)
     {
-        data_meteo.push_back(Data());
-        getMeteo(datapath_meteo[i],data_meteo[i]);
+        auto timer = stage_report.time("read meteo");
+        for(int i = 0; i < datapath_meteo.size(); i++){getMeteo(datapath_meteo[i], data_meteo);};
+        for(auto &series : data_meteo){stage_report.count("read meteo", "rows", series.second.timed.size());};
+        stage_report.count("read meteo", "files", datapath_meteo.size());
+        stage_report.count("read meteo", "years", data_meteo.size());
     };
-    getFlask(datapath_flask, data_flask);
-    getEvent(datapath_event, data_event, data_flask);
-    getMonth(datapath_month, data_month);
-
-    drawEventGraph(data_event, evalpath);
-    drawEventMeteoGraph(data_event, data_meteo, evalpath);
-    drawMonthGraph(data_month, evalpath);
-    drawMonthMeteoGraph(data_month, data_meteo,evalpath);
+    {
+        auto timer = stage_report.time("read samples");
+        getFlask(datapath_flask, data_flask);
+        getEvent(datapath_event, data_event, data_flask);
+        getMonth(datapath_month, data_month);
+        stage_report.count("read samples", "flask samples", data_flask.flask_no.size());
+        stage_report.count("read samples", "event samples", data_event.O18.size());
+        stage_report.count("read samples", "month samples", data_month.O18.size());
+    };
+
+    //figures are drawn in worker processes at the same time,
+    //draw is the time until the last one is done
+    auto draw_timer = stage_report.time("draw");
+    RenderQueue render(options.number("render", 0));
+    if (render.workers() > 1){gROOT->SetBatch(kTRUE);};
+    render.submit("event", [&]{drawEventGraph(data_event, evalpath);});
+    render.submit("event meteo", [&]{drawEventMeteoGraph(data_event, data_meteo, evalpath);});
+    render.submit("month", [&]{drawMonthGraph(data_month, evalpath);});
+    render.submit("month meteo", [&]{drawMonthMeteoGraph(data_month, data_meteo,evalpath);});
+    render.wait();
+    draw_timer.stop();
+    stage_report.count("draw", "figures", render.submitted());
+    logger.summary();
+    stage_report.write(options.get("report", evalpath + "/Rainwater_report"));
 
 
 
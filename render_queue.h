@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////////////////////
+// Background drawing of graphs for the Picarro L-2130i tools             //
+// author: Sebastian Stezura // E-Mail: sebastian_stezura@gmx.net         //
+// GitHub: CplusplusB                                                     //
+// version: 1 // date: 17.10.2026                                         //
+////////////////////////////////////////////////////////////////////////////
+
+//a draw function (canvas, graphs, Print to png) is given as job and runs in its own worker process,
+//so the figures of a year are rasterised on all cores while the program goes on
+//the worker is forked when the job is submitted: it sees the data as it was at that moment
+//(copy on write), later changes of the program do not reach it and nothing has to be copied
+//ROOT drawing uses global state (gPad, gStyle, ...) and is not made for threads, processes avoid that
+//a fork is only safe while no other thread runs: a lock (allocator, ROOT, iostream) held by another
+//thread stays locked in the worker, so the logger thread is ended for the fork (logger.suspend())
+//and the threads are counted, programs with parallel loops end their idle TBB threads before the
+//figures (releaseThreads(), thread_limit.h), if another thread still runs the job is drawn here
+//with one worker, or where there is no fork or the threads can not be counted (only Linux), a job runs right away in the program itself
+//the program should set ROOT to batch mode before the first job, so no worker opens a window
+
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+//background thread of the logger is ended before a fork
+#include "logger.h"
+
+#include <string> //for using strings
+#include <vector> //for using vectors
+#include <map> //for running jobs
+#include <functional> //for the jobs
+#include <iostream> //for Input/Output functions
+#include <thread> //for the number of cores
+#include <cstdlib> //for exit codes
+#include <cerrno> //for interrupted waits
+
+#if defined(__linux__)
+#include <unistd.h> //for fork
+#include <sys/wait.h> //for waitpid
+#include <dirent.h> //for counting the threads
+#define RENDER_FORK 1
+#else
+#define RENDER_FORK 0
+#endif
+
+class RenderQueue
+{
+public:
+    //workers: number of jobs drawn at the same time, 0 for all cores
+    RenderQueue(size_t workers = 0)
+    {
+        workers_ = workers > 0 ? workers : std::thread::hardware_concurrency();
+        if (workers_ == 0 || !RENDER_FORK){workers_ = 1;};
+    };
+    ~RenderQueue(){wait();};
+
+    size_t workers() const {return workers_;};
+
+    //draw in a worker, waits for a free worker if all are busy
+    void submit(const std::string &name, std::function<void()> job)
+    {
+        submitted_++;
+#if RENDER_FORK
+        if (workers_ > 1)
+        {
+            while (running_.size() >= workers_){reap();};
+            logger.suspend();
+            std::cout.flush();
+            pid_t pid = -1;
+            size_t threads = threadCount();
+            if (threads == 1){pid = fork();};
+            if (pid == 0)
+            {
+                int status = 0;
+                try {job();}
+                catch (...) {status = 1;};
+                std::cout.flush();
+                _exit(status);
+            };
+            logger.resume();
+            if (pid > 0){running_[pid] = name; return;};
+            if (threads == 1){std::cout << "Could not start worker for " << name << ", drawing it here" << std::endl;}
+            else if (!warned_)
+            {
+                std::cout << threads << " threads are running, figures are drawn in the program" << std::endl;
+                warned_ = 1;
+            };
+        };
+#endif
+        try {job();}
+        catch (...) {failed_.push_back(name);};
+    };
+
+    //waits for all jobs, true if all of them finished without error
+    bool wait()
+    {
+        while (!running_.empty()){reap();};
+        for (size_t i = 0; i < failed_.size(); i++){std::cout << "Drawing " << failed_[i] << " failed" << std::endl;};
+        bool ok = failed_.empty();
+        failed_.clear();
+        return ok;
+    };
+
+    size_t submitted() const {return submitted_;};
+
+private:
+    //waits for the worker that finishes first
+    void reap()
+    {
+#if RENDER_FORK
+        for (;;)
+        {
+            int status = 0;
+            pid_t pid = waitpid(-1, &status, 0);
+            if (pid < 0 && errno == EINTR){continue;};
+            if (pid < 0)
+            {
+                //no child left, the workers can not be waited for
+                for (auto &job : running_){failed_.push_back(job.second);};
+                running_.clear();
+                return;
+            };
+            auto itr = running_.find(pid);
+            if (itr == running_.end()){continue;}; //not a worker
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0){failed_.push_back(itr->second);};
+            running_.erase(itr);
+            return;
+        };
+#endif
+    };
+
+    //threads of the program, 0 if they can not be counted
+    static size_t threadCount()
+    {
+#if RENDER_FORK
+        DIR *dir = opendir("/proc/self/task");
+        if (!dir){return 0;};
+        size_t n = 0;
+        while (dirent *entry = readdir(dir)){if (entry->d_name[0] != '.'){n++;};};
+        closedir(dir);
+        return n;
+#else
+        return 0;
+#endif
+    };
+
+    size_t workers_;
+    size_t submitted_ = 0;
+    std::map<long, std::string> running_; //process id and name of every running job
+    std::vector<std::string> failed_;
+    bool warned_ = 0;
+};
+
+#endif
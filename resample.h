@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////////////////////
+// Time based resampling for the Picarro L-2130i tools                    //
+// author: Sebastian Stezura // E-Mail: sebastian_stezura@gmx.net         //
+// GitHub: CplusplusB                                                     //
+// version: 1 // date: 17.10.2026                                         //
+////////////////////////////////////////////////////////////////////////////
+
+//bins of fixed wall clock length (1 min, 10 min, 1 h, 1 day, ...) on the epoch seconds,
+//a bin starts at a multiple of its length (days at 00:00 UTC), so bins never reach over a gap:
+//samples before and after an outage, a memory skip or a Standard run end up in different bins
+//only bins with samples are written, each with count, mean, stdev, min and max of every channel
+//the samples are streamed once in time order, missing values (NaN) are not counted
+
+#ifndef RESAMPLE_H
+#define RESAMPLE_H
+
+//summary of a channel inside an interval
+#include "interval_stats.h"
+
+#include <vector> //for using vectors
+#include <cstdint> //fixed size types
+#include <cmath> //for NaN check
+#include <algorithm> //for fill
+#include <utility> //for move
+
+//binned series, stats[channel][bin]
+struct BinnedSeries
+{
+    int64_t bin_seconds = 0;
+    std::vector<int64_t> begin; //epoch of the first second of every bin
+    std::vector<std::vector<IntervalStats>> stats;
+
+    size_t size() const {return begin.size();};
+};
+
+//streaming resampler, push samples in time order
+class Resampler
+{
+public:
+    Resampler(int64_t bin_seconds, size_t channels)
+    {
+        out_.bin_seconds = bin_seconds > 0 ? bin_seconds : 1;
+        out_.stats.resize(channels);
+        current_.resize(channels);
+    };
+
+    //values has one entry per channel
+    //a sample before the current bin opens a new bin, the series then has that bin twice
+    void push(int64_t epoch, const double *values)
+    {
+        int64_t begin = binBegin(epoch);
+        if (!open_ || begin != begin_){close(); open(begin);};
+        for (size_t c = 0; c < current_.size(); c++)
+        {
+            if (!std::isnan(values[c])){current_[c].add(values[c]);};
+        };
+    };
+
+    //closes the last bin, the series is complete afterwards
+    BinnedSeries &finish()
+    {
+        close();
+        return out_;
+    };
+
+    //first second of the bin of epoch, also for times before 1970
+    int64_t binBegin(int64_t epoch) const
+    {
+        int64_t q = epoch / out_.bin_seconds;
+        if (epoch % out_.bin_seconds < 0){q--;};
+        return q * out_.bin_seconds;
+    };
+
+private:
+    void open(int64_t begin)
+    {
+        begin_ = begin;
+        open_ = 1;
+        std::fill(current_.begin(), current_.end(), RunningStats());
+    };
+    void close()
+    {
+        if (!open_){return;};
+        open_ = 0;
+        out_.begin.push_back(begin_);
+        for (size_t c = 0; c < current_.size(); c++){out_.stats[c].push_back(intervalStats(current_[c]));};
+    };
+
+    BinnedSeries out_;
+    std::vector<RunningStats> current_;
+    int64_t begin_ = 0;
+    bool open_ = 0;
+};
+
+//bins of whole columns, channels[c][i] is the value of channel c at epoch[i]
+inline BinnedSeries resample(const std::vector<int64_t> &epoch, const std::vector<const std::vector<double>*> &channels, int64_t bin_seconds)
+{
+    Resampler resampler(bin_seconds, channels.size());
+    std::vector<double> values(channels.size());
+    for (size_t i = 0; i < epoch.size(); i++)
+    {
+        for (size_t c = 0; c < channels.size(); c++){values[c] = (*channels[c])[i];};
+        resampler.push(epoch[i], values.data());
+    };
+    return std::move(resampler.finish());
+};
+
+#endif
@@ -0,0 +1,237 @@
+////////////////////////////////////////////////////////////////////////////
+// Pre-aggregated rollups of time series for the Picarro L-2130i tools    //
+// author: Sebastian Stezura // E-Mail: sebastian_stezura@gmx.net         //
+// GitHub: CplusplusB                                                     //
+// version: 1 // date: 17.10.2026                                         //
+////////////////////////////////////////////////////////////////////////////
+
+//count, sum and sum of squares of every channel per hour, day, month and hour of day x month,
+//so diurnal cycles, monthly means etc. are read from a few hundred cells instead of the whole series
+//the cache is a text file next to the evaluation output, a run only adds the rows after the last cached
+//time (the watermark), rows up to the watermark are hashed and all levels are summed fresh if they changed
+//(new calibration, other meteo file, ...), missing values (NaN) are not counted
+//all times are epoch seconds (UTC)
+
+#ifndef ROLLUP_H
+#define ROLLUP_H
+
+//epoch to calendar
+#include "picarro_time.h"
+//hash for the cached rows
+#include "ingest_store.h"
+
+#include <string> //for using strings
+#include <vector> //for using vectors
+#include <map> //for the cells
+#include <filesystem> //for replacing the cache file
+#include <fstream> //for the cache file
+#include <sstream> //for reading the cache file
+#include <limits> //for NaN
+#include <cstdint> //fixed size types
+#include <cstring> //for memcpy
+#include <cstdlib> //for strtoull
+#include <cmath> //for sqrt
+
+enum RollupLevel
+{
+    rollup_hour, //key: epoch hour
+    rollup_day, //key: epoch day
+    rollup_month, //key: year*12 + month-1
+    rollup_hour_month, //key: (month-1)*24 + hour
+    rollup_levels
+};
+
+//one channel in one cell
+struct RollupCell
+{
+    long count = 0;
+    double sum = 0.;
+    double sumsq = 0.;
+
+    void add(double x){count++; sum += x; sumsq += x*x;};
+    void merge(const RollupCell &other){count += other.count; sum += other.sum; sumsq += other.sumsq;};
+    double mean() const {return count > 0 ? sum / count : std::numeric_limits<double>::quiet_NaN();};
+    //sample standard deviation
+    double stdev() const
+    {
+        if (count < 2){return std::numeric_limits<double>::quiet_NaN();};
+        double m2 = sumsq - sum * sum / count;
+        return m2 > 0. ? std::sqrt(m2 / (count - 1)) : 0.;
+    };
+};
+
+class RollupCache
+{
+public:
+    //cells[key][channel] of one level
+    typedef std::map<int64_t, std::vector<RollupCell>> Cells;
+
+    //channels names the columns given to update, other names or rebuild start an empty cache
+    RollupCache(std::string path, const std::vector<std::string> &channels, bool rebuild = 0)
+    {
+        path_ = path;
+        channels_ = channels.size();
+        std::string settings = "Rollup 1";
+        for (size_t c = 0; c < channels.size(); c++){settings += "\t" + channels[c];};
+        settings_ = hashText(hashContent(settings));
+        if (!rebuild){load();};
+    };
+
+    //brings the cache to the series, values[c][i] is channel c at epoch[i]
+    //returns the number of rows added
+    size_t update(const std::vector<int64_t> &epoch, const std::vector<const std::vector<double>*> &values)
+    {
+        //rows up to the watermark have to be the ones in the cache
+        uint64_t hash = 0;
+        size_t prefix = 0;
+        for (size_t i = 0; i < epoch.size(); i++)
+        {
+            if (epoch[i] > watermark_){continue;};
+            hash = hashRow(hash, epoch, values, i);
+            prefix++;
+        };
+        bool fresh = rows_ == 0 || prefix != rows_ || hash != hash_;
+        if (fresh){clear();};
+
+        size_t added = 0;
+        int64_t watermark = watermark_;
+        for (size_t i = 0; i < epoch.size(); i++)
+        {
+            if (!fresh && epoch[i] <= watermark_){continue;};
+            add(epoch[i], values, i);
+            rows_++;
+            added++;
+            if (epoch[i] > watermark){watermark = epoch[i];};
+        };
+        watermark_ = watermark;
+        //the next run hashes all rows up to the new watermark in file order
+        if (added > 0){rehash(epoch, values);};
+        return added;
+    };
+
+    //write the cache, false if it could not be written
+    bool save() const
+    {
+        std::string tmp = path_ + ".tmp";
+        {
+            std::ofstream outFile(tmp, std::ios::trunc);
+            if (!outFile.is_open()){return 0;};
+            outFile << "settings\t" << settings_ << "\t" << watermark_ << "\t" << rows_ << "\t" << hashText(hash_) << "\n";
+            outFile.precision(17);
+            for (int level = 0; level < rollup_levels; level++)
+            {
+                for (auto &item : levels_[level])
+                {
+                    outFile << level << "\t" << item.first;
+                    for (const RollupCell &cell : item.second){outFile << "\t" << cell.count << "\t" << cell.sum << "\t" << cell.sumsq;};
+                    outFile << "\n";
+                };
+            };
+            if (!outFile.good()){return 0;};
+        };
+        std::error_code ec;
+        std::filesystem::rename(tmp, path_, ec);
+        return !ec;
+    };
+
+    const Cells &level(RollupLevel level) const {return levels_[level];};
+    size_t rows() const {return rows_;};
+
+    //cells of hour of day x month summed over the months, 24 cells per channel
+    std::vector<std::vector<RollupCell>> hourOfDay() const
+    {
+        std::vector<std::vector<RollupCell>> hours(24, std::vector<RollupCell>(channels_));
+        for (auto &item : levels_[rollup_hour_month])
+        {
+            for (size_t c = 0; c < channels_; c++){hours[item.first % 24][c].merge(item.second[c]);};
+        };
+        return hours;
+    };
+
+    static int64_t monthKey(int year, int month){return year * 12 + month - 1;};
+    static int monthOfKey(int64_t key){return key % 12 + 1;};
+
+private:
+    void clear()
+    {
+        for (int level = 0; level < rollup_levels; level++){levels_[level].clear();};
+        watermark_ = std::numeric_limits<int64_t>::min();
+        rows_ = 0;
+        hash_ = 0;
+    };
+
+    void add(int64_t t, const std::vector<const std::vector<double>*> &values, size_t i)
+    {
+        int year, month, day, hour, min, sec;
+        civilFromEpoch(t, year, month, day, hour, min, sec);
+        int64_t days = t >= 0 ? t/86400 : (t - 86399)/86400;
+        int64_t key[rollup_levels] = {days*24 + hour, days, monthKey(year, month), (month-1)*24 + hour};
+        for (int level = 0; level < rollup_levels; level++)
+        {
+            std::vector<RollupCell> &cells = levels_[level][key[level]];
+            cells.resize(channels_);
+            for (size_t c = 0; c < channels_; c++)
+            {
+                double x = (*values[c])[i];
+                if (x == x){cells[c].add(x);};
+            };
+        };
+    };
+
+    //running hash of the rows in the order they are given
+    uint64_t hashRow(uint64_t hash, const std::vector<int64_t> &epoch, const std::vector<const std::vector<double>*> &values, size_t i)
+    {
+        row_.resize(8 * (channels_ + 1));
+        memcpy(&row_[0], &epoch[i], 8);
+        for (size_t c = 0; c < channels_; c++){memcpy(&row_[8 * (c + 1)], &(*values[c])[i], 8);};
+        return (hash ^ hashContent(row_)) * 0x100000001b3ULL;
+    };
+
+    void rehash(const std::vector<int64_t> &epoch, const std::vector<const std::vector<double>*> &values)
+    {
+        hash_ = 0;
+        for (size_t i = 0; i < epoch.size(); i++)
+        {
+            if (epoch[i] <= watermark_){hash_ = hashRow(hash_, epoch, values, i);};
+        };
+    };
+
+    void load()
+    {
+        clear();
+        std::ifstream inFile(path_);
+        std::string line, tag, settings, hash;
+        if (!getline(inFile, line)){return;};
+        std::stringstream head(line);
+        int64_t watermark;
+        size_t rows;
+        if (!getline(head, tag, '\t') || !getline(head, settings, '\t') || tag != "settings" || settings != settings_){return;};
+        if (!(head >> watermark >> rows >> hash)){return;};
+        while (getline(inFile, line))
+        {
+            std::stringstream stst(line);
+            int level;
+            int64_t key;
+            if (!(stst >> level >> key) || level < 0 || level >= rollup_levels){clear(); return;};
+            std::vector<RollupCell> cells(channels_);
+            for (size_t c = 0; c < channels_; c++)
+            {
+                if (!(stst >> cells[c].count >> cells[c].sum >> cells[c].sumsq)){clear(); return;};
+            };
+            levels_[level][key] = cells;
+        };
+        watermark_ = watermark;
+        rows_ = rows;
+        hash_ = strtoull(hash.c_str(), nullptr, 16);
+    };
+
+    std::string path_, settings_;
+    std::string row_; //bytes of the row that is hashed
+    size_t channels_;
+    Cells levels_[rollup_levels];
+    int64_t watermark_ = std::numeric_limits<int64_t>::min();
+    size_t rows_ = 0;
+    uint64_t hash_ = 0;
+};
+
+#endif
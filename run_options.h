@@ -0,0 +1,188 @@
+////////////////////////////////////////////////////////////////////////////
+// Command line and config file options for the Picarro L-2130i tools    //
+// author: Sebastian Stezura // E-Mail: sebastian_stezura@gmx.net         //
+// GitHub: CplusplusB                                                     //
+// version: 1 // date: 17.10.2026                                         //
+////////////////////////////////////////////////////////////////////////////
+
+//every program takes the same kind of options:
+//  --key value or --key=value   on the command line, a flag without value is "1"
+//  --config FILE                "key = value" per line, '#' starts a comment, command line wins
+//  --batch                      never opens a dialog or asks for input, missing options are an error
+//  --threads N                  number of threads for the parallel loops (default all cores), only
+//                               in the programs with parallel loops, see thread_limit.h
+//  --report PREFIX              stage times and counters of the run (stage_report.h)
+//  --log LEVEL                  error, warn, info (default) or debug messages (logger.h), --quiet is warn
+//  --years FIRST-LAST           all years of the range in one run instead of --year (year_range.h)
+//  --help                       list the options of the program
+//options that are not given are asked with the file dialogs like before, so
+//"./Ambient.o" still works by clicking and "./Ambient.o --config nightly.cfg --batch" runs under cron
+
+#ifndef RUN_OPTIONS_H
+#define RUN_OPTIONS_H
+
+#include "tinyfiledialogs.h"
+#include "logger.h" //for the log level
+#include "year_range.h" //for --years
+
+#include <iostream> //for Input/Output functions
+#include <string> //for using strings
+#include <vector> //for using vectors
+#include <map> //for the options
+#include <fstream> //for reading the config file
+#include <sstream> //for splitting lists
+#include <cstdlib> //for exit
+
+class RunOptions
+{
+public:
+    //usage lists the options of the program for --help, one per line
+    RunOptions(int argc, char* argv[], std::string usage)
+    {
+        usage_ = usage;
+        std::map<std::string, std::string> cli;
+        for (int i = 1; i < argc; i++)
+        {
+            std::string arg = argv[i];
+            if (arg.size() < 3 || arg.substr(0,2) != "--")
+            {
+                std::cout << "Unknown argument " << arg << std::endl;
+                help(1);
+            };
+            arg = arg.substr(2);
+            size_t eq = arg.find('=');
+            if (eq != std::string::npos){cli[arg.substr(0,eq)] = arg.substr(eq+1);}
+            else if (i+1 < argc && std::string(argv[i+1]).substr(0,2) != "--"){cli[arg] = argv[++i];}
+            else {cli[arg] = "1";};
+        };
+        if (cli.count("help")){help(0);};
+        if (cli.count("config")){readConfig(cli["config"]);};
+        for (auto &option : cli){options_[option.first] = option.second;};
+        batch_ = flag("batch");
+        if (flag("quiet")){logger.setLevel(log_warn);};
+        if (has("log") && !logger.setLevel(get("log"))){std::cout << "Unknown log level " << get("log") << ", using info" << std::endl;};
+    };
+
+    bool batch() const {return batch_;};
+    bool has(const std::string &key) const {return options_.count(key) > 0;};
+    std::string get(const std::string &key, const std::string &def = "") const
+    {
+        auto itr = options_.find(key);
+        return itr == options_.end() ? def : itr->second;
+    };
+    bool flag(const std::string &key) const
+    {
+        std::string value = get(key, "0");
+        return value != "0" && value != "false" && value != "no";
+    };
+    long number(const std::string &key, long def) const
+    {
+        if (!has(key)){return def;};
+        try {return std::stol(get(key));}
+        catch (...)
+        {
+            std::cout << "Option --" << key << " needs a number, not " << get(key) << std::endl;
+            std::exit(1);
+        };
+    };
+    //comma separated values
+    std::vector<std::string> list(const std::string &key) const
+    {
+        std::vector<std::string> values;
+        std::stringstream stst(get(key));
+        std::string value;
+        while (getline(stst, value, ',')){if (!value.empty()){values.push_back(value);};};
+        return values;
+    };
+
+    //--year or asked on the terminal
+    std::string year()
+    {
+        if (has("year")){return get("year");};
+        required("year");
+        std::string year;
+        std::cout << "Which year?" << std::endl;
+        std::cin >> year;
+        options_["year"] = year;
+        return year;
+    };
+    //--years FIRST-LAST, else the single year of --year or asked on the terminal
+    YearRange years()
+    {
+        YearRange range;
+        std::string text = has("years") ? get("years") : year();
+        if (!YearRange::parse(text, range))
+        {
+            std::cout << "Option --" << (has("years") ? "years" : "year") << " needs a year or FIRST-LAST, not " << text << std::endl;
+            std::exit(1);
+        };
+        return range;
+    };
+    //--key or chosen with the file dialog
+    std::string openFile(const std::string &key, const char *title, int n_patterns, const char * const *patterns)
+    {
+        if (has(key)){return get(key);};
+        required(key);
+        const char *path = tinyfd_openFileDialog(title, ".", n_patterns, patterns, NULL, 0);
+        return path ? path : "";
+    };
+    //--key or chosen with the folder dialog
+    std::string selectFolder(const std::string &key, const char *title)
+    {
+        if (has(key)){return get(key);};
+        required(key);
+        const char *path = tinyfd_selectFolderDialog(title, ".");
+        return path ? path : "";
+    };
+
+private:
+    std::map<std::string, std::string> options_;
+    std::string usage_;
+    bool batch_ = 0;
+
+    void readConfig(const std::string &path)
+    {
+        std::ifstream inFile(path);
+        if (!inFile.is_open())
+        {
+            std::cout << "Could not open config file " << path << std::endl;
+            std::exit(1);
+        };
+        std::string line;
+        while (getline(inFile, line))
+        {
+            line = line.substr(0, line.find('#'));
+            size_t eq = line.find('=');
+            if (eq == std::string::npos){continue;};
+            std::string key = trim(line.substr(0, eq));
+            if (key.substr(0,2) == "--"){key = key.substr(2);};
+            if (!key.empty()){options_[key] = trim(line.substr(eq+1));};
+        };
+    };
+    static std::string trim(std::string value)
+    {
+        size_t begin = value.find_first_not_of(" \t\r");
+        if (begin == std::string::npos){return "";};
+        size_t end = value.find_last_not_of(" \t\r");
+        return value.substr(begin, end-begin+1);
+    };
+    //missing option in batch mode ends the program
+    void required(const std::string &key) const
+    {
+        if (!batch_){return;};
+        std::cout << "Missing option --" << key << " (running with --batch)" << std::endl;
+        std::exit(1);
+    };
+    void help(int code) const
+    {
+        std::cout << "options:" << std::endl << usage_;
+        std::cout << "  --config FILE      key = value per line, command line wins" << std::endl;
+        std::cout << "  --batch            no dialogs, missing options are an error" << std::endl;
+        std::cout << "  --report PREFIX    stage times and counters to PREFIX.json and PREFIX.csv" << std::endl;
+        std::cout << "  --log LEVEL        error, warn, info or debug (default info), --quiet is warn" << std::endl;
+        std::cout << "  --years FIRST-LAST all years of the range in one run, instead of --year" << std::endl;
+        std::exit(code);
+    };
+};
+
+#endif
@@ -0,0 +1,64 @@
+////////////////////////////////////////////////////////////////////////////
+// Streaming statistics for the Picarro L-2130i tools                     //
+// author: Sebastian Stezura // E-Mail: sebastian_stezura@gmx.net         //
+// GitHub: CplusplusB                                                     //
+// version: 1 // date: 17.10.2026                                         //
+////////////////////////////////////////////////////////////////////////////
+
+//count, mean, spread, min and max of values that are added one by one (Welford),
+//no vector of the values is needed and two accumulators of parts of the data can be merged
+//(Chan et al.), so every thread sums its own part and the parts are merged in a fixed order
+
+#ifndef RUNNING_STATS_H
+#define RUNNING_STATS_H
+
+#include <limits> //for NaN
+#include <cmath> //for sqrt
+
+struct RunningStats
+{
+    long count = 0;
+    double mean = 0.;
+    double m2 = 0.; //sum of squared differences from the mean
+    double total = 0.; //sum of the values in the order they were added
+    double min = std::numeric_limits<double>::quiet_NaN();
+    double max = std::numeric_limits<double>::quiet_NaN();
+
+    void add(double x)
+    {
+        if (count == 0 || x < min){min = x;};
+        if (count == 0 || x > max){max = x;};
+        count++;
+        total += x;
+        double delta = x - mean;
+        mean += delta / count;
+        m2 += delta * (x - mean);
+    };
+
+    void merge(const RunningStats &other)
+    {
+        if (other.count == 0){return;};
+        if (count == 0){*this = other; return;};
+        long n = count + other.count;
+        double delta = other.mean - mean;
+        mean += delta * other.count / n;
+        m2 += other.m2 + delta * delta * count / n * other.count;
+        if (other.min < min){min = other.min;};
+        if (other.max > max){max = other.max;};
+        total += other.total;
+        count = n;
+    };
+
+    //NaN without values
+    double average() const {return count > 0 ? mean : std::numeric_limits<double>::quiet_NaN();};
+    double sum() const {return total;};
+    //sample variance and standard deviation, 0 for one value
+    double variance() const
+    {
+        if (count == 0){return std::numeric_limits<double>::quiet_NaN();};
+        return count > 1 ? m2 / (count - 1) : 0.;
+    };
+    double stdev() const {return std::sqrt(variance());};
+};
+
+#endif
@@ -0,0 +1,200 @@
+////////////////////////////////////////////////////////////////////////////
+// Stage times and counters of the Picarro L-2130i tools                  //
+// author: Sebastian Stezura // E-Mail: sebastian_stezura@gmx.net         //
+// GitHub: CplusplusB                                                     //
+// version: 1 // date: 17.10.2026                                         //
+////////////////////////////////////////////////////////////////////////////
+
+//every program splits its run into stages (read, average, correct, draw, write, ...),
+//a scoped timer adds the time of a stage and counters add rows read, rows rejected, join misses, ...
+//at the end the program writes PREFIX.json and PREFIX.csv ("--report PREFIX"), so runs can be compared
+//stages and counters keep the order they were first used in
+//counting is thread safe, loops over many rows should count in a local variable and add it once
+
+#ifndef STAGE_REPORT_H
+#define STAGE_REPORT_H
+
+#include <string> //for using strings
+#include <vector> //for using vectors
+#include <map> //for the counters
+#include <mutex> //for counting from threads
+#include <chrono> //for timing
+#include <ctime> //for the start time
+#include <fstream> //for the report files
+#include <iostream> //for Input/Output functions
+#include <iomanip> //for the number format
+#include <sstream> //for the summary
+#include <cstdio> //for snprintf
+
+class StageReport
+{
+public:
+    StageReport(){start_ = std::chrono::steady_clock::now(); started_ = std::time(nullptr);};
+
+    //adds its lifetime to the stage, or the time until stop()
+    class Timer
+    {
+    public:
+        Timer(StageReport &report, const std::string &stage) : report_(report), stage_(stage), start_(std::chrono::steady_clock::now()){};
+        ~Timer(){stop();};
+        Timer(const Timer&) = delete;
+        Timer &operator=(const Timer&) = delete;
+        void stop()
+        {
+            if (stopped_){return;};
+            stopped_ = 1;
+            report_.addTime(stage_, std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count());
+        };
+    private:
+        StageReport &report_;
+        std::string stage_;
+        std::chrono::steady_clock::time_point start_;
+        bool stopped_ = 0;
+    };
+
+    void setProgram(const std::string &program){program_ = program;};
+    //name and value of a setting of the run (year, input, options, ...)
+    void info(const std::string &key, const std::string &value)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!info_.count(key)){info_order_.push_back(key);};
+        info_[key] = value;
+    };
+
+    //auto timer = stage_report.time("read ambient");
+    Timer time(const std::string &stage){return Timer(*this, stage);};
+
+    void count(const std::string &stage, const std::string &counter, long n = 1)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Stage &s = entry(stage);
+        if (!s.counters.count(counter)){s.order.push_back(counter);};
+        s.counters[counter] += n;
+    };
+
+    void addTime(const std::string &stage, double seconds)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Stage &s = entry(stage);
+        s.seconds += seconds;
+        s.calls++;
+    };
+
+    long counter(const std::string &stage, const std::string &counter) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto itr = index_.find(stage);
+        if (itr == index_.end()){return 0;};
+        auto c = stages_[itr->second].counters.find(counter);
+        return c == stages_[itr->second].counters.end() ? 0 : c->second;
+    };
+
+    //writes prefix.json and prefix.csv and prints the stages, false if a file could not be written
+    bool write(const std::string &prefix) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        double total = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+        char started[32];
+        std::strftime(started, sizeof(started), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&started_));
+
+        //formatted apart, the number format of cout stays as the program set it
+        std::ostringstream summary;
+        summary << std::fixed << std::setprecision(3) << "Stage times of " << program_ << ":\n";
+        for (const Stage &s : stages_)
+        {
+            summary << "  " << s.name << ": " << s.seconds << " s";
+            for (const std::string &c : s.order){summary << ", " << c << " " << s.counters.at(c);};
+            summary << "\n";
+        };
+        summary << "  total: " << total << " s\n";
+        std::cout << summary.str() << std::flush;
+
+        std::ofstream json(prefix + ".json", std::ios::trunc);
+        json << std::fixed << std::setprecision(6);
+        json << "{\n  \"program\": \"" << escape(program_) << "\",\n  \"started\": \"" << started << "\",\n  \"total_seconds\": " << total << ",\n";
+        json << "  \"info\": {";
+        for (size_t i = 0; i < info_order_.size(); i++)
+        {
+            json << (i ? ", " : "") << "\"" << escape(info_order_[i]) << "\": \"" << escape(info_.at(info_order_[i])) << "\"";
+        };
+        json << "},\n  \"stages\": [";
+        for (size_t k = 0; k < stages_.size(); k++)
+        {
+            const Stage &s = stages_[k];
+            json << (k ? "," : "") << "\n    {\"name\": \"" << escape(s.name) << "\", \"seconds\": " << s.seconds << ", \"calls\": " << s.calls << ", \"counters\": {";
+            for (size_t i = 0; i < s.order.size(); i++)
+            {
+                json << (i ? ", " : "") << "\"" << escape(s.order[i]) << "\": " << s.counters.at(s.order[i]);
+            };
+            json << "}}";
+        };
+        json << "\n  ]\n}\n";
+
+        std::ofstream csv(prefix + ".csv", std::ios::trunc);
+        csv << std::fixed << std::setprecision(6);
+        csv << "program,started,stage,metric,value\n";
+        for (const Stage &s : stages_)
+        {
+            csv << program_ << "," << started << "," << s.name << ",seconds," << s.seconds << "\n";
+            csv << program_ << "," << started << "," << s.name << ",calls," << s.calls << "\n";
+            for (const std::string &c : s.order){csv << program_ << "," << started << "," << s.name << "," << c << "," << s.counters.at(c) << "\n";};
+        };
+        csv << program_ << "," << started << ",total,seconds," << total << "\n";
+        bool ok = json.good() && csv.good();
+        if (!ok){std::cout << "Could not write report to " << prefix << ".json/.csv" << std::endl;};
+        return ok;
+    };
+
+private:
+    struct Stage
+    {
+        std::string name;
+        double seconds = 0.;
+        long calls = 0;
+        std::map<std::string, long> counters;
+        std::vector<std::string> order;
+    };
+
+    Stage &entry(const std::string &name)
+    {
+        auto itr = index_.find(name);
+        if (itr != index_.end()){return stages_[itr->second];};
+        index_[name] = stages_.size();
+        stages_.push_back(Stage());
+        stages_.back().name = name;
+        return stages_.back();
+    };
+
+    //JSON string, control characters as \u00XX
+    static std::string escape(const std::string &text)
+    {
+        std::string out;
+        for (char c : text)
+        {
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char code[8];
+                std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned char>(c));
+                out += code;
+                continue;
+            };
+            if (c == '"' || c == '\\'){out += '\\';};
+            out += c;
+        };
+        return out;
+    };
+
+    std::string program_;
+    std::chrono::steady_clock::time_point start_;
+    std::time_t started_;
+    std::vector<Stage> stages_;
+    std::map<std::string, size_t> index_;
+    std::map<std::string, std::string> info_;
+    std::vector<std::string> info_order_;
+    mutable std::mutex mutex_;
+};
+
+//one report per program
+inline StageReport stage_report;
+
+#endif
@@ -9,6 +9,9 @@
 //Draw Graphs to visualize them
 //sort data to date
 //write data to file Standards_eval_end_data_YEAR.txt
+//"./Standards_eval_corr.o --input DIR --output DIR --year YEAR --ids FILE --batch" runs without dialogs, see run_options.h
+//"--years 2018-2022" writes Standards_eval_end_data_corr2018-2022.txt of all files for eval_air_std.cc
+//parsed files are kept in Standards_data_YEAR_store, later runs only parse new or changed files and draw their Graphs ("--rebuild" parses all again)
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // compile command:                                                                                                                    //
@@ -25,6 +28,28 @@
 //////////////////////////////////////////////////////////////////////////////////
 #include "tinyfiledialogs.h"
 
+//shared reader for Picarro csv files
+#include "picarro_reader.h"
+//typed columns for class Data
+#include "data_columns.h"
+//csv files of the folder in time order
+#include "file_catalog.h"
+//rows of all files in time order
+#include "time_merge.h"
+//only new or changed files are parsed
+#include "column_store.h"
+#include "ingest_store.h"
+//command line and config file options
+#include "run_options.h"
+//--threads for the parallel loops
+#include "thread_limit.h"
+//drawing in worker processes
+#include "render_queue.h"
+//stage times and counters
+#include "stage_report.h"
+//messages of the parallel parsing
+#include "logger.h"
+
 ////////////////////
 // C/C++ includes //
 ////////////////////
@@ -34,7 +59,9 @@
 #include <filesystem> //using c++-17 filesystem
 #include <fstream> //for reading and writing to files
 #include <sstream> //for reading files
+#include <string_view> //for fields of the mapped files
 #include <algorithm> //for different C/C++ functions
+#include <limits> //for NaN
 #include <ctime>  //for time
 #include <execution> //for parallel stuff
 #include <pthread.h> //multithreading
@@ -46,6 +73,7 @@
 /////////////////////////////
 #include <TMath.h>
 #include <TApplication.h> //showing GUI
+#include <TROOT.h> //batch mode
 #include <TSystem.h> //System functions
 #include <TCanvas.h> //Canvas for Grahps
 #include <TFrame.h> //Frame for Graphs
@@ -69,7 +97,10 @@ namespace fs = std::filesystem;
 class Data
 {
 public:
-    vector<string> analysis, port, identifier, inj_nmb, timed, ignore, H2O_mean, H2O_sd, O18, O18_sd, H2, H2_sd, CH4, temp, H2O_sl, H2O_sl_sd, first;
+    DictColumn analysis, port, identifier;
+    vector<double> timed, H2O_mean, H2O_sd, O18, O18_sd, H2, H2_sd, CH4, temp, H2O_sl, H2O_sl_sd;
+    vector<int32_t> inj_nmb, ignore, first;
+    vector<int64_t> epoch;
     vector<TDatime> date;
     string ID_name;
     string file_name = "0";
@@ -80,53 +111,30 @@ public:
     ~Data(){};
 };
 
-//getting files for evaluation
-void getFiles(vector<string> &names, vector<string> &dates, vector<string> &adresses)
+//getting files for evaluation, sorted by the time in their names
+void getFiles(string afilepath, FileCatalog &catalog)
 {
-    string afilepath = tinyfd_selectFolderDialog("Choose Folder with csv Files", ".");
-
-    string filesubstr;
-    fs::path pafilepath(afilepath);
-    fs::directory_iterator end_itr;
-    for (fs::directory_iterator itr(pafilepath); itr != end_itr; ++itr)
-    {
-        if (fs::is_regular_file(itr->path()))
-        {
-            filesubstr = itr->path().filename().string();
-            filesubstr = filesubstr.substr(filesubstr.size()-4,4);
-            if (filesubstr == ".csv")
-            {
-                names.push_back(itr->path().filename().string());
-                dates.push_back(itr->path().filename().string().substr(itr->path().filename().string().size()-19, 8));
-                adresses.push_back(itr->path());
-            };
-        };
-    };
+    catalog.scan(afilepath, ".csv");
     cout << "===================" << endl;
     cout << "Reading files" << endl;
     cout << "===================" << endl;
 
-    for (int i = 0; i < names.size(); i++)
+    for (int i = 0; i < catalog.size(); i++)
     {
-        cout << i << ". " << names[i] << " from " << dates[i] << " at " << adresses[i] << endl;
+        cout << i << ". " << catalog[i].name << " from " << catalog[i].start << " at " << catalog[i].path << endl;
+        if (catalog[i].start < 0){cout << "   no time in file name, evaluated after the others" << endl;};
     };
 };
 
 //check identifier
-bool checkID_same(vector<string> identifier, string data_ID)
+bool checkID_same(const Dictionary &identifier, string_view data_ID)
 {
-    bool ID_same = 0;
-    for (int i = 0; i < identifier.size(); i++)
-    {
-        if (identifier[i] == data_ID){ID_same = 1;};
-    };
-    return ID_same;
+    return identifier.contains(data_ID);
 };
 
 //get identifers
-void getID(vector<string> &identifiers)
+void getID(string afilepath, Dictionary &identifiers)
 {
-    string afilepath = tinyfd_openFileDialog("Choose File with ID names", ".", 0, NULL, NULL, 0);
     ifstream inFile (afilepath);
     cout << "IDs:" << endl;
     if (inFile.is_open())
@@ -135,7 +143,7 @@ void getID(vector<string> &identifiers)
         while (getline(inFile, line))
         {
             remove(line.begin(), line.end(), ' ');
-            identifiers.push_back(line);
+            identifiers.add(line);
             cout << line << endl;
         };
     };
@@ -143,99 +151,63 @@ void getID(vector<string> &identifiers)
 };
 
 //getting Data from files
-void getData(string name, string files_adress, Data &data, vector<string> ID_names)
+void getData(string name, string files_adress, Data &data, const Dictionary &ID_names)
 {
-    string line_r, analysis_r, time_code_r, port_r, inj_nmb_r, O18w_r, H2w_r, H2Ow_mean_r, ignore_r, good_r, O18v_r, H2v_r, H2Ov_mean_r, identifier1_r, identifier2_r, gas_conf_r, time_mean_r, O18_sd_r, H2_sd_r, H2O_sd_r, O18_sl_r, H2_sl_r, H2O_sl_r, base_shift_r, slope_r, res_r, base_curv_r, interval_r, CH4_r, H2O_adj_r, H2O_shift_r, n2_r, temp_r, tray_r, sample_r, job_r, method_r, error_r;
+    string_view field[picarro_columns];
+    string identifier_buf;
+    TimeStamp time_stamp;
     TDatime date_code;
-    //loop over alle files
-    ifstream inFile (files_adress);
-    cout << "Reading file " << name << " ..." << endl;
+    //map file, lines and fields are views into the mapping
+    MappedFile inFile (files_adress);
+    logger.info("Reading file ", name, " ...");
     data.file_name = name;
 
     double O18, H2O_sl;
     // read signal values from file
-	if (inFile.is_open())
+	if (inFile.isOpen())
 	{
         int i = 0;
-        string line;
+        long n_rows = 0, n_bad_time = 0;
+        string_view text = inFile.view();
+        string_view line;
         bool first_true = 0;
         string last_analysis = "0";
         string last_analysis_true = "0";
+        LogTally &bad_time = logger.tally("rows with unreadable time code");
+        LogTally &bad_value = logger.tally("rows with unreadable O18 or H2O slope");
 
-        while (getline(inFile, line))
+        while (nextLine(text, line))
 		{
-            remove(line.begin(), line.end(), ' ');
-            stringstream stst(line);
-            getline(stst,line_r,',');
-            getline(stst,analysis_r,',');
-            getline(stst,time_code_r,',');
-            getline(stst,port_r,',');
-            getline(stst,inj_nmb_r,',');
-            getline(stst,O18w_r,',');
-            getline(stst,H2w_r,',');
-            getline(stst,H2Ow_mean_r,',');
-            getline(stst,ignore_r,',');
-            getline(stst,good_r,',');
-            getline(stst,O18v_r,',');
-            getline(stst,H2v_r,',');
-            getline(stst,H2Ov_mean_r,',');
-            getline(stst,identifier1_r,',');
-            getline(stst,identifier2_r,',');
-            getline(stst,gas_conf_r,',');
-            getline(stst,time_mean_r,',');
-            getline(stst,O18_sd_r,',');
-            getline(stst,H2_sd_r,',');
-            getline(stst,H2O_sd_r,',');
-            getline(stst,O18_sl_r,',');
-            getline(stst,H2_sl_r,',');
-            getline(stst,H2O_sl_r,',');
-            getline(stst,base_shift_r,',');
-            getline(stst,slope_r,',');
-            getline(stst,res_r,',');
-            getline(stst,base_curv_r,',');
-            getline(stst,interval_r,',');
-            getline(stst,CH4_r,',');
-            getline(stst,H2O_adj_r,',');
-            getline(stst,H2O_shift_r,',');
-            getline(stst,n2_r,',');
-            getline(stst,temp_r,',');
-            getline(stst,tray_r,',');
-            getline(stst,sample_r,',');
-            getline(stst,job_r,',');
-            getline(stst,method_r,',');
-            getline(stst,error_r,',');
-
-            //format time format
-            remove(time_code_r.begin(), time_code_r.end(), '/');
-            remove(time_code_r.begin(), time_code_r.end(), ':');
-            for (int j = 0; j < 4; j++) {if (!time_code_r.empty()) {time_code_r.pop_back();};};
-            //time_code_r.insert(10,1,' ');
+            splitFields(line, ',', field, picarro_columns);
+            string_view line_r = field[col_line];
+            string_view analysis_r = field[col_analysis];
+            string_view O18w_r = field[col_O18w];
+            string_view identifier2_r = stripSpaces(field[col_identifier2], identifier_buf);
 
             if (i == 0) {i = 1; continue;};
-            try
+            n_rows++;
+            //decode time "YYYY/MM/DD HH:MM:SS.sss"
+            if (decodeTimestamp(field[col_time_code], time_stamp))
             {
-                date_code.Set
-                (
-                    stoi(time_code_r.substr(0,4)),
-                    stoi(time_code_r.substr(4,2)),
-                    stoi(time_code_r.substr(6,2)),
-                    stoi(time_code_r.substr(8,2)),
-                    stoi(time_code_r.substr(10,2)),
-                    stoi(time_code_r.substr(12,2))
-                );
-                if(O18w_r == ""){O18w_r = "0.";};
-                O18 = stod(O18w_r);
-                H2O_sl = stod(H2O_sl_r);
+                date_code.Set(time_stamp.year, time_stamp.month, time_stamp.day, time_stamp.hour, time_stamp.min, time_stamp.sec);
             }
-            catch (...)
+            else
             {
-                cout << "Time Code: " << time_code_r << " at " << time_mean_r << "||" << H2O_sl_r << endl;
-            }
+                bad_time.add("Time Code: ", field[col_time_code], " at ", field[col_time_mean], "||", field[col_H2O_sl]);
+                n_bad_time++;
+                time_stamp = TimeStamp();
+                time_stamp.time_code = numeric_limits<double>::quiet_NaN();
+            };
+            if(O18w_r == ""){O18 = 0.;}
+            else if(!parseDouble(O18w_r, O18) || !parseDouble(field[col_H2O_sl], H2O_sl))
+            {
+                bad_value.add("Time Code: ", field[col_time_code], " at ", field[col_time_mean], "||", field[col_H2O_sl]);
+            };
 
-            if (time_code_r.substr(0,4) == "2018"){data.min = -3.9; data.max = -2.6;};
-            if (time_code_r.substr(0,4) == "2019"){data.min = -3.9; data.max = -2.4;};
-            if (time_code_r.substr(0,4) == "2020"){data.min = -3.2; data.max = -2.2;};
-            if (time_code_r.substr(0,4) == "2021"){data.min = -3.2; data.max = -2.2;};
+            if (time_stamp.year == 2018){data.min = -3.9; data.max = -2.6;};
+            if (time_stamp.year == 2019){data.min = -3.9; data.max = -2.4;};
+            if (time_stamp.year == 2020){data.min = -3.2; data.max = -2.2;};
+            if (time_stamp.year == 2021){data.min = -3.2; data.max = -2.2;};
 
             if (checkID_same(ID_names, identifier2_r) && identifier2_r != "" && O18 >= data.min && O18 <= data.max)// && O18w_r != "")
             {
@@ -252,68 +224,65 @@ void getData(string name, string files_adress, Data &data, vector<string> ID_nam
                 {
                     first_true = 1;
                     last_analysis_true = analysis_r;
-                    cout << "First data " << line_r << " at " << time_code_r << endl;
+                    logger.debug("First data ", line_r, " at ", formatNumber(time_stamp.time_code));
                 };
 
-                if(first_true == 1)
-                {
-                    data.first.push_back("1");
-                }
-                else
-                {
-                    data.first.push_back("0");
-                };
-                data.port.push_back(port_r);
+                data.first.push_back(first_true);
+                data.port.push_back(field[col_port]);
                 data.analysis.push_back(analysis_r);
-                data.timed.push_back(time_code_r);
+                data.timed.push_back(time_stamp.time_code);
+                data.epoch.push_back(time_stamp.epoch);
                 data.identifier.push_back(identifier2_r);
                 //lines without data set to specific values to display them
                 if(O18w_r == "")
                 {
-                    data.O18.push_back("0.");
-                    data.H2O_mean.push_back("0");
-                    data.ignore.push_back("-2");
-                    data.H2O_sd.push_back("0.");
-                    data.O18_sd.push_back("0.");
-                    data.H2.push_back("0.");
-                    data.H2_sd.push_back("0.");
-                    data.temp.push_back("0.");
-                    data.CH4.push_back("0.");
-                    data.H2O_sl.push_back("0.");
-                    cout << "Set 0 at " << analysis_r << " with ID " << identifier2_r << endl;
+                    data.O18.push_back(0.);
+                    data.H2O_mean.push_back(0.);
+                    data.ignore.push_back(-2);
+                    data.H2O_sd.push_back(0.);
+                    data.O18_sd.push_back(0.);
+                    data.H2.push_back(0.);
+                    data.H2_sd.push_back(0.);
+                    data.temp.push_back(0.);
+                    data.CH4.push_back(0.);
+                    data.H2O_sl.push_back(0.);
+                    logger.debug("Set 0 at ", analysis_r, " with ID ", identifier2_r);
 
                 }
                 else
                 {
-                    data.ignore.push_back(ignore_r);
-                    data.H2O_mean.push_back(H2Ow_mean_r);
-                    data.H2O_sd.push_back(H2O_sd_r);
-                    data.O18.push_back(O18w_r);
-                    data.O18_sd.push_back(O18_sd_r);
-                    data.H2.push_back(H2w_r);
-                    data.H2_sd.push_back(H2_sd_r);
-                    data.temp.push_back(temp_r);
-                    data.CH4.push_back(CH4_r);
-                    data.H2O_sl.push_back(H2O_sl_r);
+                    data.ignore.push_back(parseCount(field[col_ignore]));
+                    data.H2O_mean.push_back(parseValue(field[col_H2Ow_mean]));
+                    data.H2O_sd.push_back(parseValue(field[col_H2O_sd]));
+                    data.O18.push_back(O18);
+                    data.O18_sd.push_back(parseValue(field[col_O18_sd]));
+                    data.H2.push_back(parseValue(field[col_H2w]));
+                    data.H2_sd.push_back(parseValue(field[col_H2_sd]));
+                    data.temp.push_back(parseValue(field[col_temp]));
+                    data.CH4.push_back(parseValue(field[col_CH4]));
+                    data.H2O_sl.push_back(parseValue(field[col_H2O_sl]));
                 };
 
-                data.inj_nmb.push_back(inj_nmb_r);
+                data.inj_nmb.push_back(parseCount(field[col_inj_nmb]));
                 data.date.push_back(date_code);
             };
 		};
+        stage_report.count("parse", "rows read", n_rows);
+        stage_report.count("parse", "bad time codes", n_bad_time);
+        stage_report.count("parse", "Standard rows", data.timed.size());
 	};
     inFile.close();
 
 };
 
 //get unique identifiers
-void getUnique(vector<string> &unique, Data &data)
+void getUnique(Dictionary &unique, Data &data)
 {
     for (int i = 0; i < data.port.size(); i++)
     {
         if (!checkID_same(unique, data.identifier[i]))
         {
-            unique.push_back(data.identifier[i]);
+            unique.add(data.identifier[i]);
             cout << "Found dataname: " << data.identifier[i] << " in " << data.file_name << endl;
         };
 
@@ -321,14 +290,84 @@ void getUnique(vector<string> &unique, Data &data)
 
 };
 
-//check date
-bool int_compare(int i, int j)
+//parsed file as segment of the ingest store
+bool writeSegment(string path, Data &data)
 {
-    return (i < j);
+    StoreWriter store("Standards");
+    store.meta = data.file_name;
+    store.addDouble("Time", data.timed);
+    store.addInt64("Epoch", data.epoch);
+    store.addDict("Analysis", data.analysis);
+    store.addDict("Port", data.port);
+    store.addDict("Identifier", data.identifier);
+    store.addInt32("Ignore", data.ignore);
+    store.addInt32("Inj_nmb", data.inj_nmb);
+    store.addDouble("H2O mean", data.H2O_mean);
+    store.addDouble("H2O sd", data.H2O_sd);
+    store.addDouble("O18", data.O18);
+    store.addDouble("O18 sd", data.O18_sd);
+    store.addDouble("H2", data.H2);
+    store.addDouble("H2 sd", data.H2_sd);
+    store.addDouble("temperature", data.temp);
+    store.addDouble("CH4", data.CH4);
+    store.addDouble("H2O sl", data.H2O_sl);
+    store.addInt32("first", data.first);
+    return store.write(path);
+};
+
+//file from its segment instead of parsing it again
+bool readSegment(string path, Data &data)
+{
+    StoreReader store(path);
+    if (!store.isOpen()){return 0;};
+    vector<string> doubles = {"Time", "H2O mean", "H2O sd", "O18", "O18 sd", "H2", "H2 sd", "temperature", "CH4", "H2O sl"};
+    vector<vector<double>*> columns = {&data.timed, &data.H2O_mean, &data.H2O_sd, &data.O18, &data.O18_sd, &data.H2, &data.H2_sd, &data.temp, &data.CH4, &data.H2O_sl};
+    vector<string> counts = {"Ignore", "Inj_nmb", "first"};
+    vector<vector<int32_t>*> count_columns = {&data.ignore, &data.inj_nmb, &data.first};
+    vector<string> dicts = {"Analysis", "Port", "Identifier"};
+    vector<DictColumn*> dict_columns = {&data.analysis, &data.port, &data.identifier};
+    size_t n = store.rows();
+
+    const int64_t *epoch = store.getInt64("Epoch");
+    if (!epoch){return 0;};
+    data.epoch.assign(epoch, epoch + n);
+    for (size_t c = 0; c < doubles.size(); c++)
+    {
+        const double *values = store.getDouble(doubles[c]);
+        if (!values){return 0;};
+        columns[c]->assign(values, values + n);
+    };
+    for (size_t c = 0; c < counts.size(); c++)
+    {
+        const int32_t *values = store.getInt32(counts[c]);
+        if (!values){return 0;};
+        count_columns[c]->assign(values, values + n);
+    };
+    for (size_t c = 0; c < dicts.size(); c++)
+    {
+        const int32_t *codes = store.getCodes(dicts[c]);
+        if (!codes){return 0;};
+        const vector<string_view> &names = store.dictionary(dicts[c]);
+        dict_columns[c]->reserve(n);
+        for (size_t i = 0; i < n; i++){dict_columns[c]->push_back(names[codes[i]]);};
+    };
+    //date is not stored, same as the time code
+    int year, month, day, hour, min, sec;
+    for (size_t i = 0; i < n; i++)
+    {
+        TDatime date_code;
+        if (data.timed[i] > 0.)
+        {
+            splitTimeCode(data.timed[i], year, month, day, hour, min, sec);
+            date_code.Set(year, month, day, hour, min, sec);
+        };
+        data.date.push_back(date_code);
+    };
+    return 1;
 };
 
 //write evaluated Data
-void writeData(string year, string evalpath, vector<string> files_name, vector<Data> &data)
+void writeData(string year, string evalpath, const vector<string> &files_name, const vector<Data> &data)
 {
     time_t t = time(0);
     string c_time = ctime(&t);
@@ -348,13 +387,22 @@ void writeData(string year, string evalpath, vector<string> files_name, vector<D
     outFile << endl << "========================" << endl << "Raw Data" << endl << "========================" << endl;
     outFile << "Time," << "Analaysis No," << "Port,"<< "Identifier," << "Ignore," << "Inj_nmb," << "H2O mean," << "H2O sd," << "O18," << "O18 sd," << "H2," << "H2 sd," << "temperature," << "CH4," << "H2O sl," << "first" << endl;
 
-    for (int i = 0; i < data.size(); i++)
+    //rows of all files merged in time order, rows of overlapping files only once
+    vector<const vector<double>*> times;
+    for (int i = 0; i < data.size(); i++){times.push_back(&data[i].timed);};
+    TimeMerge merge(times, [&data](size_t f, size_t r, size_t g, size_t s)
     {
-        for (int j = 0; j < data[i].timed.size(); j++)
-        {
-            outFile << data[i].timed[j] << "," << data[i].analysis[j] << "," << data[i].port[j] << "," << data[i].identifier[j] << "," << data[i].ignore[j] << "," << data[i].inj_nmb[j] << "," << data[i].H2O_mean[j] << "," << data[i].H2O_sd[j] << "," << data[i].O18[j] << "," << data[i].O18_sd[j] << "," << data[i].H2[j] << "," << data[i].H2_sd[j] << "," << data[i].temp[j] << "," << data[i].CH4[j] << "," << data[i].H2O_sl[j] << "," << data[i].first[j] << endl;
-        };
+        const Data &a = data[f], &b = data[g];
+        return a.analysis[r] == b.analysis[s] && a.port[r] == b.port[s] && a.identifier[r] == b.identifier[s] && a.ignore[r] == b.ignore[s] && a.inj_nmb[r] == b.inj_nmb[s] && a.first[r] == b.first[s]
+            && sameValue(a.H2O_mean[r], b.H2O_mean[s]) && sameValue(a.H2O_sd[r], b.H2O_sd[s]) && sameValue(a.O18[r], b.O18[s]) && sameValue(a.O18_sd[r], b.O18_sd[s])
+            && sameValue(a.H2[r], b.H2[s]) && sameValue(a.H2_sd[r], b.H2_sd[s]) && sameValue(a.temp[r], b.temp[s]) && sameValue(a.CH4[r], b.CH4[s]) && sameValue(a.H2O_sl[r], b.H2O_sl[s]);
+    });
+    size_t i, j;
+    while (merge.next(i, j))
+    {
+        outFile << formatNumber(data[i].timed[j]) << "," << data[i].analysis[j] << "," << data[i].port[j] << "," << data[i].identifier[j] << "," << formatNumber(data[i].ignore[j]) << "," << formatNumber(data[i].inj_nmb[j]) << "," << formatNumber(data[i].H2O_mean[j]) << "," << formatNumber(data[i].H2O_sd[j]) << "," << formatNumber(data[i].O18[j]) << "," << formatNumber(data[i].O18_sd[j]) << "," << formatNumber(data[i].H2[j]) << "," << formatNumber(data[i].H2_sd[j]) << "," << formatNumber(data[i].temp[j]) << "," << formatNumber(data[i].CH4[j]) << "," << formatNumber(data[i].H2O_sl[j]) << "," << data[i].first[j] << "\n";
     };
+    cout << "Merged rows from " << merge.runs() << " time ordered runs, " << merge.duplicates() << " duplicate rows dropped" << endl;
 };
 
 //Draw Graph
@@ -374,8 +422,8 @@ void drawGraph(Data &data_std, string evalpath, string year)
     int width = 8000;
     int height = 3000;
 
-    string now_analysis;
-    string last_analysis = "0";
+    int32_t now_analysis;
+    int32_t last_analysis = -1;
 
     TCanvas *cO18 = new TCanvas("O^{18}","O^{18}",0,0,width,height);
 
@@ -388,15 +436,16 @@ void drawGraph(Data &data_std, string evalpath, string year)
 
     for (int i = 0; i < data_std.timed.size(); i++)
     {
-        now_analysis = data_std.analysis[i];
+        if(data_std.inj_nmb[i] == missing_int){continue;};
+        now_analysis = data_std.analysis.codes[i];
         if(now_analysis != last_analysis)
         {
-            if(data_std.first[i] == "1")
+            if(data_std.first[i] == 1)
             {
-                x.push_back(stod(data_std.inj_nmb[i]));
-                y.push_back(stod(data_std.O18[i]));
+                x.push_back(data_std.inj_nmb[i]);
+                y.push_back(data_std.O18[i]);
                 x_err.push_back(0.);
-                // y_err.push_back(stod(data_std.O18_sd[i]));
+                // y_err.push_back(data_std.O18_sd[i]);
                 y_err.push_back(0.);
             }
             else
@@ -405,35 +454,35 @@ void drawGraph(Data &data_std, string evalpath, string year)
                 y_o.push_back(vector<double>());
                 x_o_err.push_back(vector<double>());
                 y_o_err.push_back(vector<double>());
-                x_o.back().push_back(stod(data_std.inj_nmb[i])+x_o.size()/20.);
-                y_o.back().push_back(stod(data_std.O18[i]));
+                x_o.back().push_back(data_std.inj_nmb[i]+x_o.size()/20.);
+                y_o.back().push_back(data_std.O18[i]);
                 x_o_err.back().push_back(0.);
                 y_o_err.back().push_back(0.);
-                // y_o_err.back().push_back(stod(data_std.O18_sd[i]));
+                // y_o_err.back().push_back(data_std.O18_sd[i]);
             };
         }
         else if(now_analysis == last_analysis)
         {
-            if(data_std.first[i] == "1")
+            if(data_std.first[i] == 1)
             {
-                x.push_back(stod(data_std.inj_nmb[i]));
-                y.push_back(stod(data_std.O18[i]));
+                x.push_back(data_std.inj_nmb[i]);
+                y.push_back(data_std.O18[i]);
                 x_err.push_back(0.);
-                //y_err.push_back(stod(data_std.O18_sd[i]));
+                //y_err.push_back(data_std.O18_sd[i]);
                 y_err.push_back(0.);
             }
             else
             {
-                x_o.back().push_back(stod(data_std.inj_nmb[i])+x_o.size()/20.);
-                y_o.back().push_back(stod(data_std.O18[i]));
+                x_o.back().push_back(data_std.inj_nmb[i]+x_o.size()/20.);
+                y_o.back().push_back(data_std.O18[i]);
                 x_o_err.back().push_back(0.);
                 y_o_err.back().push_back(0.);
-                //y_o_err.back().push_back(stod(data_std.O18_sd[i]));
+                //y_o_err.back().push_back(data_std.O18_sd[i]);
             };
         }
         else
         {
-            cout << "Conditions broke at " << data_std.timed[i] << " ..." << endl;
+            cout << "Conditions broke at " << formatNumber(data_std.timed[i]) << " ..." << endl;
         };
         last_analysis = now_analysis;
     };
@@ -476,7 +525,7 @@ void drawGraph(Data &data_std, string evalpath, string year)
     ///////////
     //H2 graphs
     ///////////
-    last_analysis = "0";
+    last_analysis = -1;
 
     TCanvas *cH2 = new TCanvas("H^{2}","H^{2}",0,0,width,height);
 
@@ -491,16 +540,17 @@ void drawGraph(Data &data_std, string evalpath, string year)
 
     for (int i = 0; i < data_std.timed.size(); i++)
     {
-        now_analysis = data_std.analysis[i];
+        if(data_std.inj_nmb[i] == missing_int){continue;};
+        now_analysis = data_std.analysis.codes[i];
         if(now_analysis != last_analysis)
         {
-            if(data_std.first[i] == "1")
+            if(data_std.first[i] == 1)
             {
-                x.push_back(stod(data_std.inj_nmb[i]));
-                y.push_back(stod(data_std.H2[i]));
+                x.push_back(data_std.inj_nmb[i]);
+                y.push_back(data_std.H2[i]);
                 x_err.push_back(0.);
                 y_err.push_back(0.);
-                // y_err.push_back(stod(data_std.H2_sd[i]));
+                // y_err.push_back(data_std.H2_sd[i]);
             }
             else
             {
@@ -508,35 +558,35 @@ void drawGraph(Data &data_std, string evalpath, string year)
                 y_h.push_back(vector<double>());
                 x_h_err.push_back(vector<double>());
                 y_h_err.push_back(vector<double>());
-                x_h.back().push_back(stod(data_std.inj_nmb[i])+x_h.size()/20.);
-                y_h.back().push_back(stod(data_std.H2[i]));
+                x_h.back().push_back(data_std.inj_nmb[i]+x_h.size()/20.);
+                y_h.back().push_back(data_std.H2[i]);
                 x_h_err.back().push_back(0.);
-                // y_h_err.back().push_back(stod(data_std.H2_sd[i]));
+                // y_h_err.back().push_back(data_std.H2_sd[i]);
                 y_h_err.back().push_back(0.);
             };
         }
         else if(now_analysis == last_analysis)
         {
-            if(data_std.first[i] == "1")
+            if(data_std.first[i] == 1)
             {
-                x.push_back(stod(data_std.inj_nmb[i]));
-                y.push_back(stod(data_std.H2[i]));
+                x.push_back(data_std.inj_nmb[i]);
+                y.push_back(data_std.H2[i]);
                 x_err.push_back(0.);
                 y_err.push_back(0.);
-                // y_err.push_back(stod(data_std.H2_sd[i]));
+                // y_err.push_back(data_std.H2_sd[i]);
             }
             else
             {
-                x_h.back().push_back(stod(data_std.inj_nmb[i])+x_h.size()/20.);
-                y_h.back().push_back(stod(data_std.H2[i]));
+                x_h.back().push_back(data_std.inj_nmb[i]+x_h.size()/20.);
+                y_h.back().push_back(data_std.H2[i]);
                 x_h_err.back().push_back(0.);
-                // y_o_err.back().push_back(stod(data_std.H2_sd[i]));
+                // y_o_err.back().push_back(data_std.H2_sd[i]);
                 y_h_err.back().push_back(0.);
             };
         }
         else
         {
-            cout << "Conditions broke at " << data_std.timed[i] << " ..." << endl;
+            cout << "Conditions broke at " << formatNumber(data_std.timed[i]) << " ..." << endl;
         };
         last_analysis = now_analysis;
     };
@@ -575,122 +625,119 @@ void drawGraph(Data &data_std, string evalpath, string year)
 
 int main(int argc, char* argv[])
 {
+    RunOptions options(argc, argv,
+        "  --input DIR        folder with csv files\n"
+        "  --output DIR       folder for evaluation\n"
+        "  --year YEAR        year to evaluate\n"
+        "  --years FIRST-LAST all files of the range in one run, outputs are named FIRST-LAST\n"
+        "  --ids FILE         file with ID names of the Standards\n"
+        "  --threads N        threads for the parallel loops\n"
+        "  --rebuild          parse all files again instead of only new or changed ones\n"
+        "  --render N         figures drawn at the same time in worker processes (default all cores, 1 draws here)\n");
+    ThreadLimit threads(options.number("threads", 0));
+
     //////////////////////////////////
     // Name, date and path to files //
     //////////////////////////////////
-    vector<string> files_name;
-    vector<string> files_date;
-    vector<string> files_adress;
+    FileCatalog catalog;
     string year;
+    stage_report.setProgram("standards_eval_corr");
 
-    cout << "Which year?" << endl;
-    cin >> year;
+    //a range only names the outputs, the files of the folder are all read like for a single year
+    year = options.years().label();
 
-    getFiles(files_name, files_date, files_adress);
+    string inputpath = options.selectFolder("input", "Choose Folder with csv Files");
+    {
+        auto timer = stage_report.time("catalog");
+        getFiles(inputpath, catalog);
+        stage_report.count("catalog", "files", catalog.size());
+    };
     //choose directory for evaluation data
-    string evalpath = tinyfd_selectFolderDialog("Choose Folder for Evaluation", ".");
+    string evalpath = options.selectFolder("output", "Choose Folder for Evaluation");
     cout << "Evalpath " << evalpath << endl;
     //cout << year << endl; //debug
 
     //////////////////////////////////////////////////
     // Read csv file(s) and store values in vectors //
     //////////////////////////////////////////////////
-    vector<Data> data, data_sorted;
-    vector<string> unique_ID;
-    getID(unique_ID);
+    //one Data per file in catalog (time) order
+    vector<Data> data(catalog.size());
+    Dictionary unique_ID;
+    getID(options.openFile("ids", "Choose File with ID names", 0, NULL), unique_ID);
 
     vector<int> parItr;
-    int reservedN = 200; //How much files are there
-    for (int i = 0; i < reservedN; i++){ data.push_back(Data()); };
-
-    for (int i = 0; i < files_adress.size(); i++){ parItr.push_back(i); };
-
-    //loop over alle files and read signal
-    auto files_loop = [files_name, files_adress, &data, &unique_ID](int i)
+    for (int i = 0; i < catalog.size(); i++){ parItr.push_back(i); };
+
+    //only new or changed files are parsed, the others come from their segments
+    //the segments depend on the ID list, a different list parses all files again
+    string settings = "Standards 1";
+    for (size_t i = 0; i < unique_ID.size(); i++){settings += "\n" + unique_ID[i];};
+    IngestStore ingest(evalpath + "/Standards_data_" + year + "_store", settings, options.flag("rebuild"));
+    vector<ManifestEntry> entries(catalog.size());
+    vector<char> parse(catalog.size()), parsed(catalog.size());
+    int n_parse = 0;
+    auto parse_timer = stage_report.time("parse");
+    for (int i = 0; i < catalog.size(); i++)
     {
-        cout << i << ". ";
-        getData(files_name[i], files_adress[i], data[i], unique_ID);
-        data[i].file_name = files_name[i];
+        parse[i] = ingest.needsParsing(catalog[i].path, entries[i]);
+        n_parse += parse[i];
     };
-    for_each(execution::par,parItr.begin(),parItr.end(), files_loop);
-
-    //////////////
-    //sort Data //
-    //////////////
-
-    string date_name;
-    long int date_int;
-    int year_akt, yearr;
-    vector<long int> date;
+    cout << "Parsing " << n_parse << " new or changed of " << catalog.size() << " files" << endl;
 
-    for (int i = 0; i < data.size(); i++)
-    {
-        if (data[i].file_name == "0"){continue;};
-        date_name = data[i].file_name.substr(18,8) + data[i].file_name.substr(27,6);
-        try
-        {
-            date_int = stol(date_name);
-        }
-        catch (...)
-        {
-            cout << "aborted because of '" << date_name << "'" << endl;
-        }
-        date.push_back(date_int);
-    };
-
-    cout << "sorting..." << endl;
-    cout << "##########" << endl;
-    std::sort(date.begin(), date.end(), int_compare);
-    for (int i = date.size()-1; i != 0; i--)
-    {
-        date_name = to_string(date[i]);
-        year_akt = stoi(date_name.substr(0,4));
-        yearr = stoi(year);
-        if (year_akt < yearr)
-        {
-            date.insert(date.begin(), date[i]);
-            date.pop_back();
-        };
-    };
-
-    for (int i = 0; i < date.size(); i++)
-    {
-        cout << date[i] << endl;
-    };
-    cout << endl;
-    cout << "########" << endl;
-
-    for (int i = 0; i < date.size(); i++)
+    //loop over alle files and read signal
+    auto files_loop = [&catalog, &data, &unique_ID, &ingest, &entries, &parse, &parsed](int i)
     {
-        for (int j = 0; j < data.size(); j++)
-        {
-            if (data[j].file_name == "0"){continue;};
-            date_name = data[j].file_name.substr(18,8) + data[j].file_name.substr(27,6);
-            //cout << "Date name: " << date_name << endl;
-            date_int = stol(date_name);
-            //cout << "Date in int: " << date_int << endl;
-            if (date[i] == date_int) {data_sorted.push_back(data[j]); cout << "sorting in " << date_int << endl;};
-        };
+        data[i].file_name = catalog[i].name;
+        if (!parse[i] && readSegment(ingest.segmentPath(entries[i]), data[i])){return;};
+        data[i] = Data();
+        getData(catalog[i].name, catalog[i].path, data[i], unique_ID);
+        data[i].file_name = catalog[i].name;
+        parsed[i] = writeSegment(ingest.segmentPath(entries[i]), data[i]);
+        parse[i] = 1;
     };
+    for_each(execution::par,parItr.begin(),parItr.end(), files_loop);
+    //lines of the workers are written before the program prints again
+    logger.flush();
+    for (int i = 0; i < catalog.size(); i++){if (parsed[i]){ingest.commit(entries[i]);};};
+    ingest.retain(catalog.paths());
+    if (!ingest.save()){cout << "Could not save manifest of " << evalpath + "/Standards_data_" + year + "_store" << endl;};
+    stage_report.count("parse", "files parsed", n_parse);
+    stage_report.count("parse", "files from store", catalog.size() - n_parse);
+    parse_timer.stop();
 
     ///////////////
     //Write to file
     ///////////////
     cout << "Writing data to file ..." << endl;
-
-    writeData(year, evalpath, files_name, data_sorted);
+    {
+        auto timer = stage_report.time("write");
+        writeData(year, evalpath, catalog.names(), data);
+    };
 
     ///////////////
     //Draw Graphs
     ///////////////
 
-    //loop over alle files and read signal
+    //Graphs of the files read from the store are already there
     cout << "Drawing graphs ..." << endl;
-    for(int i = 0; i < data.size(); i++)
+    auto draw_timer = stage_report.time("draw");
+    RenderQueue render(options.number("render", 0));
+    if (render.workers() > 1){gROOT->SetBatch(kTRUE);};
+    //the workers are forked, the threads of the parsing loop must be gone
+    releaseThreads();
+    for(int i = 0; i < catalog.size(); i++)
     {
-        if(data[i].O18.size() < 1){continue;};
-        drawGraph(data[i],evalpath,year);
+        if(data[i].O18.size() < 1 || !parse[i]){continue;};
+        render.submit(catalog[i].name, [&, i]{drawGraph(data[i],evalpath,year);});
     };
+    render.wait();
+    stage_report.count("draw", "figures", render.submitted());
+    draw_timer.stop();
+
+    stage_report.info("year", year);
+    stage_report.info("input", inputpath);
+    logger.summary();
+    stage_report.write(options.get("report", evalpath + "/Standards_" + year + "_report"));
 
 
 
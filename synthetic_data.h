@@ -0,0 +1,374 @@
+////////////////////////////////////////////////////////////////////////////
+// Synthetic input data for the Picarro L-2130i tools                     //
+// author: Sebastian Stezura // E-Mail: sebastian_stezura@gmx.net         //
+// GitHub: CplusplusB                                                     //
+// version: 1 // date: 17.10.2026                                         //
+////////////////////////////////////////////////////////////////////////////
+
+//writes a folder with the same files the programs read, for benchmarks and offline tests:
+//  csv/HIDS2380-Isotopes-YYYYMMDD-000000.csv   Picarro export with 38 columns, one file per day,
+//                                              a Standard sequence (2 conditioning vials, 1 Standard
+//                                              with 10 injections and memory) at midnight, Ambient after it
+//  ids.txt                                     identifier2 of the Standard for standards_eval_corr.cc
+//  meteo/Meteo_YYYY_10min.dat                  10 minute meteo values, one file per year
+//  rain/event.csv, rain/month.csv, rain/flask.csv   rain samples of rainwater_eval.cc
+//temperature, humidity and isotopes follow a seasonal and a diurnal cycle with noise,
+//rain events are drawn first, so the meteo precipitation and the rain samples agree
+//the same seed gives the same files
+
+#ifndef SYNTHETIC_DATA_H
+#define SYNTHETIC_DATA_H
+
+#include "picarro_time.h" //for epoch seconds and dates
+
+#include <string> //for using strings
+#include <vector> //for using vectors
+#include <fstream> //for writing the files
+#include <filesystem> //for the folders
+#include <random> //for the noise
+#include <cmath> //for sin and cos
+#include <cstdio> //for snprintf
+#include <cstdint> //fixed size types
+
+//size of the data set
+struct SynthSettings
+{
+    int64_t start = epochFromParts(2021, 1, 1, 0, 0, 0); //first day, 00:00
+    int days = 7;
+    int interval = 1; //seconds between Ambient rows
+    int injection = 540; //seconds per injection of a vial
+    uint32_t seed = 1;
+    std::string standard = "STD_KIWA"; //identifier2 of the Standard
+};
+
+//one line of a csv file, fields are added in order and separated automatically
+class CsvLine
+{
+public:
+    CsvLine(char separator) : sep_(separator){};
+    void clear(){n_ = 0;};
+    void text(const char *value){next(); while (*value && n_ < sizeof(buf_) - 1){buf_[n_++] = *value++;};};
+    void empty(){next();};
+    void number(double value, int precision){next(); n_ += std::snprintf(buf_ + n_, sizeof(buf_) - n_, "%.*f", precision, value);};
+    void count(long value){next(); n_ += std::snprintf(buf_ + n_, sizeof(buf_) - n_, "%ld", value);};
+    //returns the bytes written
+    size_t write(std::ofstream &out)
+    {
+        buf_[n_++] = '\n';
+        out.write(buf_, n_);
+        size_t bytes = n_;
+        n_ = 0;
+        first_ = 1;
+        return bytes;
+    };
+private:
+    void next(){if (!first_){buf_[n_++] = sep_;}; first_ = 0;};
+    char buf_[1024];
+    size_t n_ = 0;
+    bool first_ = 1;
+    char sep_;
+};
+
+class SynthGenerator
+{
+public:
+    uint64_t rows = 0, bytes = 0, files = 0;
+
+    SynthGenerator(const SynthSettings &settings) : set_(settings), rng_(settings.seed), noise_(0., 1.)
+    {
+        //rain events first, meteo and samples are written from them
+        std::uniform_real_distribution<double> uni(0., 1.);
+        for (int d = 0; d < set_.days; d++)
+        {
+            if (uni(rng_) > 0.3){continue;};
+            int64_t begin = set_.start + d*86400LL + static_cast<int64_t>(4 + uni(rng_)*14)*3600;
+            rain_begin_.push_back(begin);
+            rain_end_.push_back(begin + static_cast<int64_t>(1 + uni(rng_)*5)*3600);
+        };
+    };
+
+    //writes all files into folder, false if one could not be written
+    bool writeAll(const std::string &folder)
+    {
+        std::error_code ec;
+        for (const char *sub : {"/csv", "/meteo", "/rain"}){std::filesystem::create_directories(folder + sub, ec);};
+        std::ofstream ids(folder + "/ids.txt");
+        ids << set_.standard << "\n";
+        bool ok = ids.good();
+        files++;
+        for (int d = 0; d < set_.days; d++){ok = writePicarroDay(folder + "/csv", set_.start + d*86400LL) && ok;};
+        ok = writeMeteo(folder + "/meteo") && ok;
+        ok = writeRain(folder + "/rain") && ok;
+        return ok;
+    };
+
+    //years covered, for the meteo files and --year
+    std::vector<int> years() const
+    {
+        std::vector<int> out;
+        int year, month, day, hour, min, sec;
+        for (int d = 0; d < set_.days; d++)
+        {
+            civilFromEpoch(set_.start + d*86400LL, year, month, day, hour, min, sec);
+            if (out.empty() || out.back() != year){out.push_back(year);};
+        };
+        return out;
+    };
+
+    //air temperature in °C, seasonal and diurnal cycle without noise
+    static double temperature(int64_t t)
+    {
+        double season = std::cos(2.*M_PI*(dayOfYear(t) - 200.)/365.25);
+        double diurnal = std::cos(2.*M_PI*(hourOfDay(t) - 15.)/24.);
+        return 10. + 9.*season + 4.*diurnal;
+    };
+
+private:
+    static double dayOfYear(int64_t t)
+    {
+        int year, month, day, hour, min, sec;
+        civilFromEpoch(t, year, month, day, hour, min, sec);
+        return (t - epochFromParts(year, 1, 1, 0, 0, 0))/86400.;
+    };
+    static double hourOfDay(int64_t t){return (t % 86400)/3600.;};
+
+    bool raining(int64_t t) const
+    {
+        for (size_t e = 0; e < rain_begin_.size(); e++)
+        {
+            if (t >= rain_begin_[e] && t < rain_end_[e]){return 1;};
+        };
+        return 0;
+    };
+
+    //"YYYY/MM/DD HH:MM:SS.sss" or "YYYY-MM-DD HH:MM:SS"
+    static void timestamp(int64_t t, char sep, bool millis, char *out, size_t size)
+    {
+        int year, month, day, hour, min, sec;
+        civilFromEpoch(t, year, month, day, hour, min, sec);
+        if (millis){std::snprintf(out, size, "%04d%c%02d%c%02d %02d:%02d:%02d.000", year, sep, month, sep, day, hour, min, sec);}
+        else {std::snprintf(out, size, "%04d%c%02d%c%02d %02d:%02d:%02d", year, sep, month, sep, day, hour, min, sec);};
+    };
+
+    //Standard sequence and Ambient air of one day
+    bool writePicarroDay(const std::string &folder, int64_t day)
+    {
+        int year, month, d, hour, min, sec;
+        civilFromEpoch(day, year, month, d, hour, min, sec);
+        char name[64];
+        std::snprintf(name, sizeof(name), "/HIDS2380-Isotopes-%04d%02d%02d-000000.csv", year, month, d);
+        std::ofstream out(folder + name, std::ios::binary);
+        out << "Line,Analysis,Time Code,Port,Inj Nr,d(18_16)Mean,d(D_H)Mean,H2O_Mean,Ignore,Good,"
+               "d(18_16)Vapor,d(D_H)Vapor,H2O_Vapor,Identifier 1,Identifier 2,Gas Configuration,Timestamp Mean,d(18_16)_SD,d(D_H)_SD,H2O_SD,"
+               "d(18_16)_Sl,d(D_H)_Sl,H2O_Sl,baseline_shift,slope_shift,residuals,baseline_curvature,interval,ch4_ppm,h16od_adjust,"
+               "h16od_shift,n2_flag,DAS Temp,Tray,Sample,Job,Method,Error Code\n";
+        CsvLine line(',');
+        char time[32];
+
+        //vials of the sequence: O18, number of injections, identifier
+        struct Vial {double O18; int injections; const char *id;};
+        Vial vials[3] = {{-3.0, 4, "Conditioning"}, {-3.0, 4, "Conditioning"}, {-2.9, 10, set_.standard.c_str()}};
+        int64_t t = day;
+        double last = -14.; //memory of the Ambient air before
+        for (int v = 0; v < 3; v++)
+        {
+            analysis_++;
+            for (int inj = 1; inj <= vials[v].injections; inj++)
+            {
+                double O18 = vials[v].O18 + (last - vials[v].O18)*std::exp(-inj/1.2) + 0.04*noise_(rng_);
+                double H2 = 8.*O18 + 10. + 0.3*noise_(rng_);
+                timestamp(t, '/', 1, time, sizeof(time));
+                line.count(v + 1);
+                line.count(analysis_);
+                line.text(time);
+                line.text(v == 2 ? "2-03" : v == 1 ? "2-02" : "2-01");
+                line.count(inj);
+                line.number(O18, 3);
+                line.number(H2, 3);
+                line.number(20000. + 300.*noise_(rng_), 0);
+                line.count(0);
+                line.count(1);
+                line.empty(); line.empty(); line.empty();
+                line.text(vials[v].id);
+                line.text(vials[v].id);
+                line.text("H2O");
+                line.count(t);
+                line.number(0.1 + 0.01*noise_(rng_), 3);
+                line.number(0.5 + 0.05*noise_(rng_), 3);
+                line.number(150. + 10.*noise_(rng_), 1);
+                line.number(0.002*noise_(rng_), 4);
+                line.number(0.01*noise_(rng_), 4);
+                line.number(1.65 + 0.03*noise_(rng_), 3);
+                line.number(0., 3); line.number(0., 3); line.number(0.5, 3); line.number(0., 3);
+                line.number(8.5, 1);
+                line.number(0.0015, 4);
+                line.number(0., 3); line.number(0., 3);
+                line.count(0);
+                line.number(80. + 0.1*noise_(rng_), 2);
+                line.count(2);
+                line.count(v + 1);
+                line.count(1);
+                line.text("Synthetic");
+                line.count(0);
+                bytes += line.write(out);
+                rows++;
+                t += set_.injection;
+            };
+            last = vials[v].O18;
+        };
+
+        //Ambient air for the rest of the day
+        for (; t < day + 86400; t += set_.interval)
+        {
+            double temp = temperature(t) + 0.3*noise_(rng_);
+            double H2O = std::max(1500., 6000. + 450.*temp + 200.*noise_(rng_) + (raining(t) ? 4000. : 0.));
+            double O18 = -14. + 0.25*(temp - 10.) + 0.3*noise_(rng_);
+            double H2 = 8.*O18 + 10. + 1.5*noise_(rng_);
+            timestamp(t, '/', 1, time, sizeof(time));
+            line.empty(); line.empty();
+            line.text(time);
+            line.text("Ambient");
+            for (int c = 0; c < 6; c++){line.empty();};
+            line.number(O18, 3);
+            line.number(H2, 3);
+            line.number(H2O, 0);
+            line.empty(); line.empty();
+            line.text("AIR");
+            line.count(t);
+            for (int c = 0; c < 11; c++){line.empty();};
+            line.number(0.0019 + 0.0001*noise_(rng_), 4);
+            line.empty(); line.empty(); line.empty();
+            line.number(80. + 0.1*noise_(rng_), 2);
+            for (int c = 0; c < 5; c++){line.empty();};
+            bytes += line.write(out);
+            rows++;
+        };
+        files++;
+        return out.good();
+    };
+
+    //one file per year with 10 minute values
+    bool writeMeteo(const std::string &folder)
+    {
+        bool ok = 1;
+        CsvLine line(';');
+        char time[32];
+        std::ofstream out;
+        int open_year = 0;
+        for (int64_t t = set_.start; t < set_.start + set_.days*86400LL; t += 600)
+        {
+            int year, month, day, hour, min, sec;
+            civilFromEpoch(t, year, month, day, hour, min, sec);
+            if (year != open_year)
+            {
+                if (out.is_open()){ok = out.good() && ok; out.close();};
+                out.open(folder + "/Meteo_" + std::to_string(year) + "_10min.dat", std::ios::binary);
+                out << "Interval; WindVel; ConTemp; RH1; RH2; Grad; APress; O3G1; O3G3; NO; VenTemp; WindDir; Prec\n";
+                open_year = year;
+                files++;
+            };
+            double temp = temperature(t) + 0.3*noise_(rng_);
+            bool rain = raining(t);
+            double rh = std::min(100., std::max(20., 75. - 2.*(temp - 10.) + 5.*noise_(rng_) + (rain ? 20. : 0.)));
+            double sun = std::max(0., -std::cos(2.*M_PI*hourOfDay(t)/24.));
+            timestamp(t, '-', 0, time, sizeof(time));
+            line.text(time);
+            line.number(std::fabs(3. + 1.5*noise_(rng_)), 1);
+            line.number(temp + 0.1*noise_(rng_), 1);
+            line.number(rh + noise_(rng_), 1);
+            line.number(rh, 1);
+            line.number(rain ? 50.*sun : 700.*sun*(1. + 0.2*noise_(rng_)), 0);
+            line.number(970. + 5.*noise_(rng_), 1);
+            line.number(40. + 10.*sun + 3.*noise_(rng_), 1);
+            line.number(40. + 10.*sun + 3.*noise_(rng_), 1);
+            line.number(std::fabs(5. + 2.*noise_(rng_)), 1);
+            line.number(temp, 2);
+            line.number(std::fmod(360. + 240. + 40.*noise_(rng_), 360.), 0);
+            line.number(rain ? std::fabs(0.4 + 0.3*noise_(rng_)) : 0., 1);
+            bytes += line.write(out);
+            rows++;
+        };
+        if (out.is_open()){ok = out.good() && ok;};
+        return ok;
+    };
+
+    //event samples of the rain events, monthly samples and the flask masses
+    bool writeRain(const std::string &folder)
+    {
+        const int n_flasks = 20;
+        CsvLine line(',');
+        char text[32];
+        int year, month, day, hour, min, sec, year_e, month_e, day_e, hour_e;
+        std::vector<double> flask_mass(n_flasks);
+        std::ofstream flask(folder + "/flask.csv", std::ios::binary);
+        flask << "Flask, Mass\n";
+        for (int f = 0; f < n_flasks; f++)
+        {
+            flask_mass[f] = 250. + 5.*noise_(rng_);
+            line.count(f + 1);
+            line.number(flask_mass[f], 2);
+            bytes += line.write(flask);
+        };
+
+        //rain is lighter in winter
+        std::ofstream event(folder + "/event.csv", std::ios::binary);
+        for (size_t e = 0; e < rain_begin_.size(); e++)
+        {
+            civilFromEpoch(rain_begin_[e], year, month, day, hour, min, sec);
+            civilFromEpoch(rain_end_[e], year_e, month_e, day_e, hour_e, min, sec);
+            double O18 = -8. + 3.*std::cos(2.*M_PI*(dayOfYear(rain_begin_[e]) - 200.)/365.25) + 1.5*noise_(rng_);
+            line.count(year);
+            std::snprintf(text, sizeof(text), "%02d.%02d-%02d.%02d", day, month, day_e, month_e);
+            line.text(text);
+            std::snprintf(text, sizeof(text), "%02d-%02d", hour, hour_e);
+            line.text(text);
+            line.count(e % n_flasks + 1);
+            line.count(e + 1);
+            line.number(O18, 2);
+            line.number(0.05, 2);
+            line.number(8.*O18 + 10. + noise_(rng_), 2);
+            line.number(0.5, 2);
+            line.number(flask_mass[e % n_flasks] + 20. + 10.*std::fabs(noise_(rng_)), 2);
+            bytes += line.write(event);
+            rows++;
+        };
+
+        //one sample per month, from the 1st to the 1st of the next month
+        std::ofstream month_file(folder + "/month.csv", std::ios::binary);
+        int64_t end = set_.start + set_.days*86400LL;
+        int n_month = 0;
+        civilFromEpoch(set_.start, year, month, day, hour, min, sec);
+        for (int64_t t = epochFromParts(year, month, 1, 0, 0, 0); t < end; )
+        {
+            civilFromEpoch(t, year, month, day, hour, min, sec);
+            int64_t next = epochFromParts(month == 12 ? year + 1 : year, month == 12 ? 1 : month + 1, 1, 0, 0, 0);
+            double O18 = -8. + 3.*std::cos(2.*M_PI*(dayOfYear(t) - 185.)/365.25) + noise_(rng_);
+            line.count(year);
+            std::snprintf(text, sizeof(text), "%02d.01-%02d.01", month, month == 12 ? 1 : month + 1);
+            line.text(text);
+            line.text("08-08");
+            line.count(++n_month);
+            line.number(O18, 2);
+            line.number(0.05, 2);
+            line.number(8.*O18 + 10. + noise_(rng_), 2);
+            line.number(0.5, 2);
+            line.count((n_month - 1) % n_flasks + 1);
+            line.number(flask_mass[(n_month - 1) % n_flasks], 2);
+            line.number(flask_mass[(n_month - 1) % n_flasks] + 50. + 40.*std::fabs(noise_(rng_)), 2);
+            line.count(month);
+            bytes += line.write(month_file);
+            rows++;
+            t = next;
+        };
+        files += 3;
+        return flask.good() && event.good() && month_file.good();
+    };
+
+    SynthSettings set_;
+    std::mt19937_64 rng_;
+    std::normal_distribution<double> noise_;
+    std::vector<int64_t> rain_begin_, rain_end_;
+    long analysis_ = 0;
+};
+
+#endif
@@ -0,0 +1,57 @@
+////////////////////////////////////////////////////////////////////////////
+// Thread limit of the parallel loops for the Picarro L-2130i tools       //
+// author: Sebastian Stezura // E-Mail: sebastian_stezura@gmx.net         //
+// GitHub: CplusplusB                                                     //
+// version: 1 // date: 17.10.2026                                         //
+////////////////////////////////////////////////////////////////////////////
+
+//std::execution::par runs on the threads of TBB, only the programs with parallel loops
+//include this header and link -ltbb (ambient.cc, standards_eval_corr.cc), the others stay without TBB
+//  ThreadLimit threads(options.number("threads", 0));   at most N threads for the loops, 0 for all cores
+//  releaseThreads();   ends the idle TBB threads before the render workers are forked (render_queue.h),
+//                      the next parallel loop starts them again
+
+#ifndef THREAD_LIMIT_H
+#define THREAD_LIMIT_H
+
+#include <iostream> //for Input/Output functions
+#include <memory> //for the limit
+
+#if __has_include(<tbb/global_control.h>)
+#include <tbb/global_control.h> //thread limit of the parallel algorithms
+#include <tbb/version.h> //for ending the threads
+#define THREAD_LIMIT_TBB
+#endif
+
+class ThreadLimit
+{
+public:
+    //n threads at most, 0 or less keeps all cores
+    ThreadLimit(long n)
+    {
+        if (n <= 0){return;};
+#ifdef THREAD_LIMIT_TBB
+        limit_.reset(new tbb::global_control(tbb::global_control::max_allowed_parallelism, n));
+#else
+        std::cout << "Thread limit not available without TBB, using all cores" << std::endl;
+#endif
+    };
+
+private:
+#ifdef THREAD_LIMIT_TBB
+    std::unique_ptr<tbb::global_control> limit_;
+#endif
+};
+
+//waits until the idle TBB threads have ended, false if they could not be ended (TBB before 2021.6)
+inline bool releaseThreads()
+{
+#if defined(THREAD_LIMIT_TBB) && (TBB_VERSION_MAJOR > 2021 || (TBB_VERSION_MAJOR == 2021 && TBB_VERSION_MINOR >= 6))
+    tbb::task_scheduler_handle handle{tbb::attach{}};
+    return tbb::finalize(handle, std::nothrow);
+#else
+    return 0;
+#endif
+};
+
+#endif
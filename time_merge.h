@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////
+// Time ordered merge of parsed files for the Picarro L-2130i tools       //
+// author: Sebastian Stezura // E-Mail: sebastian_stezura@gmx.net         //
+// GitHub: CplusplusB                                                     //
+// version: 1 // date: 17.10.2026                                         //
+////////////////////////////////////////////////////////////////////////////
+
+//rows of all parsed files in time order, for writing the year output row by row
+//every file is cut into runs that are already in time order (usually the whole file is one run),
+//a heap holds the next row of every run, so the merge needs memory for the runs and not for the rows
+//overlapping exports contain the same rows twice: with a comparison of the written columns, a row is
+//dropped only if a row of another file with the same time was already written and all its columns are equal,
+//rows of the same file and rows that differ (e.g. other port at the same time) are always kept
+//  TimeMerge merge(times, [&](size_t f, size_t r, size_t g, size_t s){return sameValue(O18[f][r], O18[g][s]) && ...;});
+//without comparison no row is dropped, rows without time (NaN) come after all others in file order and are never dropped
+
+#ifndef TIME_MERGE_H
+#define TIME_MERGE_H
+
+#include <vector> //for using vectors
+#include <queue> //for the heap
+#include <cmath> //for NaN check
+#include <cstddef> //for size_t
+#include <functional> //for the row comparison
+
+//equal written values, NaN is written as empty field and equals NaN
+inline bool sameValue(double a, double b){return a == b || (std::isnan(a) && std::isnan(b));};
+
+class TimeMerge
+{
+public:
+    //true if row r of file f and row s of file g are written the same
+    typedef std::function<bool(size_t f, size_t r, size_t g, size_t s)> SameRow;
+
+    //times of every file, the vectors have to live as long as the merge
+    TimeMerge(const std::vector<const std::vector<double>*> &times, SameRow same = nullptr) : times_(times), same_(same)
+    {
+        for (size_t f = 0; f < times_.size(); f++)
+        {
+            const std::vector<double> &t = *times_[f];
+            size_t begin = 0;
+            for (size_t i = 1; i <= t.size(); i++)
+            {
+                if (i < t.size() && !(key(t[i]) < key(t[i-1]))){continue;};
+                runs_.push_back(Run{f, begin, i});
+                heap_.push(Head{key(t[begin]), runs_.size()-1});
+                begin = i;
+            };
+        };
+    };
+
+    //next row in time order, false after the last row
+    bool next(size_t &file, size_t &row)
+    {
+        while (!heap_.empty())
+        {
+            Head head = heap_.top();
+            heap_.pop();
+            Run &run = runs_[head.run];
+            file = run.file;
+            row = run.row++;
+            if (run.row < run.end){heap_.push(Head{key((*times_[run.file])[run.row]), head.run});};
+
+            double t = (*times_[file])[row];
+            if (!same_ || std::isnan(t)){return 1;};
+            if (group_.empty() || t != last_){group_.clear(); last_ = t;}
+            else if (duplicate(file, row)){duplicates_++; continue;};
+            group_.push_back(Row{file, row});
+            return 1;
+        };
+        return 0;
+    };
+
+    size_t runs() const {return runs_.size();};
+    size_t duplicates() const {return duplicates_;};
+
+private:
+    struct Run
+    {
+        size_t file, row, end;
+    };
+    struct Row
+    {
+        size_t file, row;
+    };
+    struct Head
+    {
+        double time;
+        size_t run;
+        //smallest time on top, same time in file order
+        bool operator<(const Head &other) const
+        {
+            if (time != other.time){return time > other.time;};
+            return run > other.run;
+        };
+    };
+    //NaN behind every time
+    static double key(double t){return std::isnan(t) ? HUGE_VAL : t;};
+    //same as a written row of another file with this time
+    bool duplicate(size_t file, size_t row) const
+    {
+        for (const Row &written : group_)
+        {
+            if (written.file != file && same_(written.file, written.row, file, row)){return 1;};
+        };
+        return 0;
+    };
+
+    std::vector<const std::vector<double>*> times_;
+    std::vector<Run> runs_;
+    std::priority_queue<Head> heap_;
+    SameRow same_;
+    std::vector<Row> group_; //written rows with time last_
+    double last_ = 0.;
+    size_t duplicates_ = 0;
+};
+
+#endif
@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////
+// Range of years for the Picarro L-2130i tools                           //
+// author: Sebastian Stezura // E-Mail: sebastian_stezura@gmx.net         //
+// GitHub: CplusplusB                                                     //
+// version: 1 // date: 17.10.2026                                         //
+////////////////////////////////////////////////////////////////////////////
+
+//a run evaluates all years of a range at once ("--years 2018-2022", see run_options.h),
+//the input files are read one time and rows outside the range are left out,
+//the data is split into the years only when results are written (one file and graph per year)
+//ambient.cc and standards_eval_corr.cc read all files of their folder anyway, a range only names their outputs
+//  YearRange years(2018, 2022);   years.contains(2020), years.list() is 2018, ..., 2022
+//  years.label()                  "2018-2022", or "2021" for a single year like before
+//  rowsByYear(time_codes, years)  rows of every year, for pickRows of every column
+
+#ifndef YEAR_RANGE_H
+#define YEAR_RANGE_H
+
+#include <string> //for using strings
+#include <vector> //for using vectors
+#include <map> //for the rows of the years
+#include <cstddef> //for size_t
+#include <cmath> //for missing time codes
+
+struct YearRange
+{
+    int first = 0, last = 0;
+
+    YearRange(){};
+    YearRange(int year) : first(year), last(year){};
+    YearRange(int first_year, int last_year) : first(first_year), last(last_year){};
+
+    bool contains(int year) const {return year >= first && year <= last;};
+    int count() const {return last - first + 1;};
+    bool single() const {return first == last;};
+    //"2021" or "2018-2022", names the files of the whole range
+    std::string label() const {return single() ? std::to_string(first) : std::to_string(first) + "-" + std::to_string(last);};
+    std::vector<int> list() const
+    {
+        std::vector<int> years;
+        for (int year = first; year <= last; year++){years.push_back(year);};
+        return years;
+    };
+
+    //"2021" or "2018-2022", false if it is no range
+    static bool parse(const std::string &text, YearRange &range)
+    {
+        try
+        {
+            size_t used = 0;
+            size_t dash = text.find('-', 1);
+            int first = std::stoi(text.substr(0, dash), &used);
+            if (used != text.substr(0, dash).size()){return 0;};
+            int last = first;
+            if (dash != std::string::npos)
+            {
+                last = std::stoi(text.substr(dash+1), &used);
+                if (used != text.substr(dash+1).size()){return 0;};
+            };
+            if (first < 1 || last < first){return 0;};
+            range = YearRange(first, last);
+            return 1;
+        }
+        catch (...) {return 0;};
+    };
+};
+
+//year of a time code YYYYMMDDHHMMSS, 0 for a missing (NaN) or impossible time code, 0 is in no range
+inline int yearOfTimeCode(double time_code)
+{
+    double year = time_code / 1e10;
+    if (!std::isfinite(year) || year < 1. || year > 9999.){return 0;};
+    return static_cast<int>(year);
+};
+
+//rows of every year of the range, in the order of the column
+inline std::map<int, std::vector<size_t>> rowsByYear(const std::vector<double> &time_code, const YearRange &years)
+{
+    std::map<int, std::vector<size_t>> rows;
+    for (int year : years.list()){rows[year];};
+    for (size_t i = 0; i < time_code.size(); i++)
+    {
+        int year = yearOfTimeCode(time_code[i]);
+        if (years.contains(year)){rows[year].push_back(i);};
+    };
+    return rows;
+};
+
+//the values of the rows, rows beyond the column are left out
+template <class T> std::vector<T> pickRows(const std::vector<T> &column, const std::vector<size_t> &rows)
+{
+    std::vector<T> picked;
+    picked.reserve(rows.size());
+    for (size_t row : rows)
+    {
+        if (row < column.size()){picked.push_back(column[row]);};
+    };
+    return picked;
+};
+
+#endif